@@ -0,0 +1,42 @@
+#include <deskgui/app.h>
+
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <string>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Webview bind Benchmark") {
+  // Driven with poll(), the main loop can't be restarted once run() returns
+  deskgui::App app;
+  auto* window = app.createWindow("window");
+  REQUIRE(window);
+  auto* webview = window->createWebview("webview");
+  REQUIRE(webview);
+
+  bool done = false;
+  webview->bind("echo", [](const std::string& payload) { return payload; });
+  webview->addCallback("done", [&done](const std::string&) { done = true; });
+
+  // Bound functions are injected on page load
+  bool loaded = false;
+  const auto loadedId = webview->connect<deskgui::event::WebviewContentLoaded>(
+      [&loaded]() { loaded = true; });
+  webview->loadHTMLString("<html><body></body></html>");
+  while (!loaded) {
+    app.poll(10ms);
+  }
+  webview->disconnect<deskgui::event::WebviewContentLoaded>(loadedId);
+
+  constexpr int kNumOfCalls = 1000;
+
+  BENCHMARK("Resolve " + std::to_string(kNumOfCalls) + " bound function calls") {
+    done = false;
+    webview->executeScript("Promise.all(Array.from({ length: " + std::to_string(kNumOfCalls)
+                           + " }, (_, i) => window.echo(i))).then(() =>"
+                             " window.webview.postMessage({ key: 'done', payload: 0 }));");
+    while (!done) {
+      app.poll(10ms);
+    }
+  };
+}
@@ -0,0 +1,64 @@
+#include <deskgui/app.h>
+
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("App dispatch Benchmark") {
+  // Driven with poll(), the main loop can't be restarted once run() returns
+  deskgui::App app;
+  auto* window = app.createWindow("window");
+  REQUIRE(window);
+
+  static constexpr int kNumOfTasks = 10000;  // Divisible by every number of producers
+
+  for (const int numOfProducers : {1, 4, 16}) {
+    BENCHMARK("Post " + std::to_string(kNumOfTasks) + " tasks from "
+              + std::to_string(numOfProducers) + " threads") {
+      std::atomic<int> remaining{kNumOfTasks};
+
+      std::vector<std::thread> producers;
+      for (int i = 0; i < numOfProducers; ++i) {
+        producers.emplace_back([&app, &remaining, numOfProducers]() {
+          for (int task = 0; task < kNumOfTasks / numOfProducers; ++task) {
+            app.postOnMainThread([&remaining]() { --remaining; });
+          }
+        });
+      }
+
+      while (remaining > 0) {
+        app.poll(10ms);
+      }
+      for (auto& producer : producers) {
+        producer.join();
+      }
+      return remaining.load();
+    };
+  }
+}
+
+TEST_CASE("Window dispatch Benchmark") {
+  // The app runs on its own thread, so that getSize is dispatched from the benchmark thread
+  std::promise<std::pair<deskgui::App*, deskgui::Window*>> started;
+  std::thread ui([&started]() {
+    deskgui::App app;
+    auto* window = app.createWindow("window");
+    started.set_value({&app, window});
+    app.run();
+  });
+
+  auto [app, window] = started.get_future().get();
+  REQUIRE(window);
+
+  BENCHMARK("Window getSize round trip from a worker thread") { return window->getSize(); };
+
+  app->terminate();
+  ui.join();
+}
@@ -1,7 +1,13 @@
 #include <deskgui/event_bus.h>
 
+#include <atomic>
 #include <catch2/catch_all.hpp>
 #include <exception>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 TEST_CASE("EventBus Benchmark") {
   deskgui::EventBus eventBus;
@@ -29,4 +35,136 @@ TEST_CASE("EventBus Benchmark") {
   BENCHMARK("Emit non-listened event to " + std::to_string(kNumOfConnections) + " connections") {
     eventBus.emit(Event2{2});
   };
+
+  BENCHMARK("Connect and disconnect a listener with captures") {
+    const std::string name = "window";
+    const auto *window = &eventBus;
+    const auto id = eventBus.connect<Event2>(
+        [&eventBus, window, name](const Event2 &) { return window == &eventBus && !name.empty(); });
+    eventBus.disconnect<Event2>(id);
+    return id;
+  };
+}
+
+TEST_CASE("EventBus concurrent Benchmark") {
+  deskgui::EventBus eventBus;
+
+  struct Event1 {
+    int value;
+  };
+
+  constexpr int kNumOfConnections = 100;
+  constexpr int kNumOfWriters = 2;
+
+  for (int i = 0; i < kNumOfConnections; ++i) {
+    eventBus.connect<Event1>([](const Event1 &) {});
+  }
+
+  // Writers keep connecting and disconnecting listeners while the benchmark thread emits
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> writers;
+  for (int i = 0; i < kNumOfWriters; ++i) {
+    writers.emplace_back([&eventBus, &stop]() {
+      while (!stop.load(std::memory_order_relaxed)) {
+        const auto id = eventBus.connect<Event1>([](const Event1 &) {});
+        eventBus.disconnect<Event1>(id);
+      }
+    });
+  }
+
+  BENCHMARK("Emit event to " + std::to_string(kNumOfConnections) + " connections while "
+            + std::to_string(kNumOfWriters) + " threads connect and disconnect") {
+    eventBus.emit(Event1{1});
+  };
+
+  stop.store(true);
+  for (auto &writer : writers) {
+    writer.join();
+  }
+}
+
+TEST_CASE("EventBus listener layout Benchmark") {
+  struct Event1 {
+    int value;
+  };
+
+  for (const int numOfConnections : {10, 1000, 100000}) {
+    deskgui::EventBus eventBus;
+
+    // Previous layout of the listeners of one event type, kept as a baseline
+    std::unordered_map<deskgui::UniqueId, std::function<void(void *)>> unorderedListeners;
+
+    int received = 0;
+    for (int i = 0; i < numOfConnections; ++i) {
+      eventBus.connect<Event1>([&received](const Event1 &event) { received += event.value; });
+      unorderedListeners.try_emplace(i, [&received](void *event) {
+        received += static_cast<Event1 *>(event)->value;
+      });
+    }
+
+    BENCHMARK("Emit event to " + std::to_string(numOfConnections) + " dense listeners") {
+      eventBus.emit(Event1{1});
+      return received;
+    };
+
+    BENCHMARK("Emit event to " + std::to_string(numOfConnections) + " unordered_map listeners") {
+      Event1 event{1};
+      for (const auto &[id, listener] : unorderedListeners) {
+        listener(&event);
+      }
+      return received;
+    };
+  }
+}
+
+TEST_CASE("EventBus keyed Benchmark") {
+  deskgui::EventBus eventBus;
+
+  struct Event1 {
+    int value;
+  };
+
+  constexpr int kNumOfKeys = 40;
+
+  int received = 0;
+  for (int i = 0; i < kNumOfKeys; ++i) {
+    eventBus.connect<Event1>("key" + std::to_string(i),
+                             [&received](const Event1 &event) { received += event.value; });
+  }
+
+  BENCHMARK("Emit keyed event with " + std::to_string(kNumOfKeys) + " keyed listeners") {
+    eventBus.emit(Event1{1}, "key20");
+    return received;
+  };
+}
+
+TEST_CASE("EventBus post Benchmark") {
+  deskgui::EventBus eventBus;
+
+  struct Event1 {
+    int value;
+  };
+
+  constexpr int kNumOfPosts = 100;
+
+  int received = 0;
+  eventBus.connect<Event1>([&received](const Event1 &event) { received += event.value; });
+  eventBus.connect<deskgui::event::WindowResize>(
+      [&received](const deskgui::event::WindowResize &) { ++received; });
+
+  BENCHMARK("Post and drain " + std::to_string(kNumOfPosts) + " events") {
+    for (int i = 0; i < kNumOfPosts; ++i) {
+      eventBus.post<Event1>(1);
+    }
+    eventBus.drain();
+    return received;
+  };
+
+  BENCHMARK("Post and drain " + std::to_string(kNumOfPosts) + " latest-wins resizes") {
+    for (int i = 0; i < kNumOfPosts; ++i) {
+      eventBus.post<deskgui::event::WindowResize>(deskgui::ViewSize{i, i});
+    }
+    eventBus.drain();
+    return received;
+  };
 }
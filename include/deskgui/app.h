@@ -8,8 +8,11 @@
 #pragma once
 
 #include <deskgui/app_handler.h>
+#include <deskgui/awaitable.h>
+#include <deskgui/background_task.h>
 #include <deskgui/window.h>
 
+#include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
@@ -23,13 +26,18 @@ namespace deskgui {
    * @brief The main application class responsible for running the deskgui application.
    *
    * @param name The name of the application. Defaults to "deskgui" if not provided.
+   * @param backgroundThreads The number of threads running background work. Defaults to one per
+   *                          hardware thread if zero.
    *
    */
   class App : public AppHandler {
   public:
     class Impl;
 
-    explicit App(const std::string& name = "deskgui");
+    explicit App(const std::string& name = "deskgui", std::size_t backgroundThreads = 0);
+
+    // Waits for the background work still queued, which must not block on the main thread, before
+    // destroying the windows
     ~App() final;
 
     /**
@@ -82,6 +90,40 @@ namespace deskgui {
      */
     void run();
 
+    /**
+     * @brief Runs one iteration of the main event loop, waiting up to a timeout for events.
+     *
+     * poll() and step() let an external event loop drive the application instead of run(). The
+     * thread calling them becomes the main thread, so windows and webviews can be used from it
+     * without dispatching. They return without dispatching anything once the application has been
+     * terminated.
+     *
+     * @param timeout The longest time to wait for an event.
+     * @return True if events or tasks were dispatched, false otherwise.
+     */
+    bool poll(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Runs one iteration of the main event loop without waiting.
+     *
+     * @return True if events or tasks were dispatched, false otherwise.
+     */
+    bool step();
+
+    /**
+     * @brief Gets what an external event loop has to wait for before calling step().
+     *
+     * On Linux, these are the file descriptors of the GTK main context and the delay until its
+     * next timeout, which can be registered with epoll or any other reactor. They may change after
+     * each iteration. Windows and macOS have no pollable descriptors: the returned timeout then
+     * asks to be stepped about once per frame.
+     *
+     * Must be called from the thread driving the event loop.
+     *
+     * @return The descriptors and timeout to wait for.
+     */
+    [[nodiscard]] PollInfo getPollInfo();
+
     /**
      * @brief Terminates the application's main event loop and destroys all windows.
      *
@@ -90,6 +132,37 @@ namespace deskgui {
      */
     void terminate();
 
+    /**
+     * @brief Runs a callback once on the main thread after a delay.
+     *
+     * Timers run on the application's main loop. Timers expiring within a few milliseconds of each
+     * other are fired together, so a timer may run slightly late but never early.
+     *
+     * @param callback The callback to run.
+     * @param delay The delay before running the callback.
+     * @return A unique ID that can be used to cancel the timer.
+     */
+    UniqueId setTimeout(TimerCallback callback, std::chrono::milliseconds delay);
+
+    /**
+     * @brief Runs a callback periodically on the main thread until it is cancelled.
+     *
+     * An interval running late skips the periods it missed instead of catching up on them.
+     *
+     * @param callback The callback to run.
+     * @param interval The period of the timer.
+     * @return A unique ID that can be used to cancel the timer.
+     * @throws std::invalid_argument If the interval is not positive.
+     */
+    UniqueId setInterval(TimerCallback callback, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Cancels a timer. Has no effect if the timer has already expired.
+     *
+     * @param id The unique ID returned by setTimeout or setInterval.
+     */
+    void cancel(UniqueId id);
+
     /**
      * @brief Checks if the application is currently running.
      *
@@ -104,17 +177,91 @@ namespace deskgui {
      */
     [[nodiscard]] bool isMainThread() const override;
 
+    /**
+     * @brief Delivers the events posted to an event bus on the main thread.
+     *
+     * @param events The event bus to drain.
+     */
+    void attachEvents(EventBus& events) override;
+
+    /**
+     * @brief Stops draining an event bus.
+     *
+     * @param events The event bus previously attached.
+     */
+    void detachEvents(EventBus& events) override;
+
+    /**
+     * @brief Awaitable moving a C++20 coroutine to the main thread.
+     *
+     * Example:
+     * @code{.cpp}
+     * co_await app.background();
+     * auto data = loadData();
+     * co_await app.mainThread();
+     * window->setTitle(data.title);
+     * @endcode
+     *
+     * @return An awaiter resuming the coroutine from the main thread's message loop.
+     */
+    [[nodiscard]] inline MainThreadAwaiter mainThread() const { return MainThreadAwaiter(*this); }
+
+    /**
+     * @brief Awaitable moving a C++20 coroutine to a library-owned worker thread.
+     *
+     * @return An awaiter resuming the coroutine on a thread pool worker.
+     */
+    [[nodiscard]] inline BackgroundAwaiter background() const {
+      return BackgroundAwaiter(backgroundPool());
+    }
+
+    /**
+     * @brief Runs work on a worker of the application's thread pool.
+     *
+     * The pool is started on first use, so applications without background work spawn no thread.
+     * Bound functions doing heavy work can move it there to keep the main thread responsive.
+     *
+     * Example:
+     * @code{.cpp}
+     * app.runInBackground([path] { return readFile(path); }).then([](std::string content) {
+     *   // Runs on the main thread
+     * });
+     * @endcode
+     *
+     * @tparam Work The type of the work function.
+     * @param work The work function, run on a worker thread.
+     * @return A task whose then() sets the continuation receiving the result on the main thread.
+     */
+    template <typename Work> auto runInBackground(Work&& work) const {
+      using Result = std::invoke_result_t<std::decay_t<Work>&>;
+      return BackgroundTask<Result>(backgroundPool(), *this, std::forward<Work>(work));
+    }
+
+    /**
+     * @brief Gets the application's thread pool, starting it on first use.
+     *
+     * @return The pool running background work, asynchronous bound functions and coroutines moved
+     * off the main thread.
+     */
+    [[nodiscard]] ThreadPool& backgroundPool() const override;
+
   private:
     std::unique_ptr<Impl> impl_{nullptr};
 
     /**
      * @brief Posts a task to the main thread's message loop
      *
-     * @tparam Task The type of the task function to be posted.
      * @param task The task function to be posted.
-     * @return The result of the task function, if applicable.
+     * @param priority The scheduling class of the task.
+     */
+    void dispatch(DispatchTask&& task, DispatchPriority priority) const override;
+
+    /**
+     * @brief Posts a request to the main thread's message loop without taking ownership of it.
+     *
+     * @param request The request to run, kept alive by the caller until it has run.
      */
-    void dispatch(DispatchTask&& task) const override;
+    void dispatch(DispatchRequest& request) const override;
 
     /**
      * @brief Gets a pointer to the application handler.
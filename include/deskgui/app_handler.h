@@ -7,17 +7,53 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <exception>
 #include <functional>
-#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <type_traits>
 
 namespace deskgui {
+  class EventBus;
+  class MainThreadAwaiter;
+  class ThreadPool;
+
   using DispatchTask = std::function<void()>;
 
+  /**
+   * @brief Scheduling class of the tasks dispatched to the main thread.
+   *
+   * Queued tasks run by class, in dispatch order within a class. Immediate tasks always run on
+   * the next main loop iteration; normal and background tasks only run until the frame budget of
+   * the iteration is spent, and the rest are left for the next iterations.
+   */
+  enum class DispatchPriority {
+    kImmediate,   // Input-critical work
+    kNormal,      // Default class
+    kBackground,  // Low-value updates, run once no normal task is left
+  };
+
+  /**
+   * @brief Intrusive task that stays owned by whoever dispatches it, until it has run.
+   *
+   * Platform queues link requests through next instead of allocating a node for them. The request
+   * may be destroyed as soon as run or cancel returns, so next must be read before calling them.
+   * Requests still queued when the application is destroyed are cancelled instead of run, which
+   * releases whoever waits for them.
+   */
+  struct DispatchRequest {
+    void (*run)(DispatchRequest& request) = nullptr;
+    void (*cancel)(DispatchRequest& request) = nullptr;  // Optional
+    DispatchRequest* next = nullptr;                      // Reserved for the platform queues
+    DispatchPriority priority = DispatchPriority::kNormal;
+  };
+
   class AppHandler {
   public:
     AppHandler() = default;
@@ -38,44 +74,167 @@ namespace deskgui {
      */
     virtual bool isMainThread() const = 0;
 
+    /**
+     * @brief Delivers the events posted to an event bus on the main thread.
+     *
+     * Once attached, the events queued with EventBus::post are drained on the next main loop
+     * iteration. Must be called from the main thread.
+     *
+     * @param events The event bus to drain.
+     */
+    virtual void attachEvents(EventBus& events) = 0;
+
+    /**
+     * @brief Stops draining an event bus. Must be called from the main thread before the bus is
+     * destroyed.
+     *
+     * @param events The event bus previously attached.
+     */
+    virtual void detachEvents(EventBus& events) = 0;
+
+    /**
+     * @brief Gets the thread pool running work off the main thread, starting it on first use.
+     *
+     * @return The application's background thread pool.
+     */
+    [[nodiscard]] virtual ThreadPool& backgroundPool() const = 0;
+
     /**
      * @brief Posts a task to the main thread's message loop in a thread-safe manner.
      *
-     * This method posts a task function to be executed on the main thread's message loop.
-     * The task function should not have any side effects on shared resources.
+     * This method posts a task function to be executed on the main thread's message loop and
+     * blocks until it has run. The task and its result stay on the caller's stack, so the round
+     * trip does not allocate. Exceptions thrown by the task are rethrown to the caller. If the
+     * application is destroyed before the task runs, a default-constructed result is returned,
+     * or std::runtime_error thrown when the result type has no default constructor.
      *
      * @tparam Task The type of the task function to be posted.
      * @param task The task function to be posted.
+     * @param priority The scheduling class of the task.
      * @return The result of the task function, if applicable.
      */
-
-    template <typename Task> auto dispatchOnMainThread(Task&& task) const {
+    template <typename Task> auto dispatchOnMainThread(
+        Task&& task, DispatchPriority priority = DispatchPriority::kNormal) const {
       using ResultType = typename std::invoke_result_t<Task>;
-      std::promise<ResultType> result;
-      auto taskWrapper = DispatchTask([task_ = std::forward<Task>(task), &result]() mutable {
-        if constexpr (std::is_void_v<ResultType>) {
-          task_();
-          result.set_value();
-        } else {
-          result.set_value(task_());
-        }
-      });
 
-      auto future = result.get_future();
+      BlockingRequest<std::remove_reference_t<Task>, ResultType> request(task);
+      request.priority = priority;
+      dispatch(request);
+      return request.get();
+    }
 
-      dispatch(std::move(taskWrapper));
+    /**
+     * @brief Posts a task to the main thread's message loop without waiting for it.
+     *
+     * Tasks posted from the same thread with the same priority run in order, and before any task
+     * dispatched afterwards from that thread with that priority.
+     *
+     * @tparam Task The type of the task function to be posted.
+     * @param task The task function to be posted.
+     * @param priority The scheduling class of the task.
+     */
+    template <typename Task> void postOnMainThread(
+        Task&& task, DispatchPriority priority = DispatchPriority::kNormal) const {
+      dispatch(DispatchTask(std::forward<Task>(task)), priority);
+    }
 
-      return future.get();
-    };
+    /**
+     * @brief Waits until the normal and immediate tasks posted so far from the calling thread
+     * have run.
+     *
+     * Window and webview methods returning void are posted when called from another thread, and
+     * can't report errors to the caller; flush() is the barrier for callers that need their
+     * effects. Background tasks are not
+     * waited for. Has no effect on the main thread, which runs them immediately.
+     */
+    void flush() const {
+      // Tasks of a class run in dispatch order, and immediate ones run before any normal task
+      if (!isMainThread()) {
+        dispatchOnMainThread([] {});
+      }
+    }
 
   protected:
     /**
      * @brief Posts a task to the main thread's message loop
      *
-     * @tparam Task The type of the task function to be posted.
      * @param task The task function to be posted.
+     * @param priority The scheduling class of the task.
      */
-    virtual void dispatch(DispatchTask&& task) const = 0;
+    virtual void dispatch(DispatchTask&& task, DispatchPriority priority) const = 0;
+
+    /**
+     * @brief Posts a request to the main thread's message loop without taking ownership of it.
+     *
+     * @param request The request to run, kept alive by the caller until it has run.
+     */
+    virtual void dispatch(DispatchRequest& request) const = 0;
+
+  private:
+    friend class MainThreadAwaiter;
+
+    // Request of dispatchOnMainThread, living on the stack of the blocked caller
+    template <typename Task, typename ResultType> class BlockingRequest : public DispatchRequest {
+    public:
+      explicit BlockingRequest(Task& task)
+          : DispatchRequest{&BlockingRequest::execute, &BlockingRequest::abandon}, task_(task) {}
+
+      ResultType get() {
+        std::unique_lock lock(mutex_);
+        finished_.wait(lock, [this] { return done_; });
+
+        if (exception_) {
+          std::rethrow_exception(exception_);
+        }
+        if constexpr (!std::is_void_v<ResultType>) {
+          return std::move(*result_);
+        }
+      }
+
+    private:
+      static void execute(DispatchRequest& request) {
+        auto& self = static_cast<BlockingRequest&>(request);
+        try {
+          if constexpr (std::is_void_v<ResultType>) {
+            self.task_();
+          } else {
+            self.result_.emplace(self.task_());
+          }
+        } catch (...) {
+          self.exception_ = std::current_exception();
+        }
+        self.finish();
+      }
+
+      static void abandon(DispatchRequest& request) {
+        auto& self = static_cast<BlockingRequest&>(request);
+        if constexpr (std::is_default_constructible_v<Result>) {
+          self.result_.emplace();
+        } else {
+          self.exception_ = std::make_exception_ptr(
+              std::runtime_error("The application was destroyed before the task ran"));
+        }
+        self.finish();
+      }
+
+      void finish() {
+        // The caller may destroy the request as soon as it sees done_, which it can only read
+        // once the lock is released: nothing is touched after that
+        std::lock_guard lock(mutex_);
+        done_ = true;
+        finished_.notify_one();
+      }
+
+      using Result = std::conditional_t<std::is_void_v<ResultType>, bool, ResultType>;
+
+      Task& task_;
+      std::optional<Result> result_;
+      std::exception_ptr exception_;
+
+      std::mutex mutex_;
+      std::condition_variable finished_;
+      bool done_ = false;
+    };
   };
 
 }  // namespace deskgui
\ No newline at end of file
@@ -0,0 +1,177 @@
+/**
+ * deskgui - A powerful and flexible C++ library to create web-based desktop applications.
+ *
+ * Copyright (c) 2023 deskgui
+ * MIT License
+ */
+
+#pragma once
+
+#include <deskgui/app_handler.h>
+#include <deskgui/thread_pool.h>
+
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace deskgui {
+
+  /**
+   * @brief Type-erased handle resuming a suspended coroutine.
+   *
+   * The awaiters below only see coroutine handles through templates, so they compile as C++17 and
+   * the library does not require C++20: only the code awaiting them does.
+   */
+  class ResumeHandle {
+  public:
+    ResumeHandle() = default;
+
+    template <typename Handle> static ResumeHandle from(Handle handle) {
+      ResumeHandle resumeHandle;
+      resumeHandle.address_ = handle.address();
+      resumeHandle.resume_ = [](void* address) { Handle::from_address(address).resume(); };
+      resumeHandle.destroy_ = [](void* address) { Handle::from_address(address).destroy(); };
+      return resumeHandle;
+    }
+
+    // Reads the handle before resuming, as the coroutine may destroy it
+    void operator()() const { resume_(address_); }
+
+    // Destroys the suspended coroutine instead of resuming it
+    void destroy() const { destroy_(address_); }
+
+  private:
+    void* address_ = nullptr;
+    void (*resume_)(void* address) = nullptr;
+    void (*destroy_)(void* address) = nullptr;
+  };
+
+  /**
+   * @brief Awaiter resuming the coroutine on the main thread. Returned by App::mainThread().
+   *
+   * The request lives in the coroutine frame while it is suspended, so resuming does not
+   * allocate. Completes immediately if the coroutine already runs on the main thread. If the
+   * application is destroyed before the coroutine is resumed, its frame is destroyed instead.
+   */
+  class MainThreadAwaiter : public DispatchRequest {
+  public:
+    explicit MainThreadAwaiter(const AppHandler& app)
+        : DispatchRequest{&MainThreadAwaiter::execute, &MainThreadAwaiter::abandon}, app_(&app) {}
+
+    [[nodiscard]] bool await_ready() const { return app_->isMainThread(); }
+
+    template <typename Handle> void await_suspend(Handle handle) {
+      resume_ = ResumeHandle::from(handle);
+      app_->dispatch(*this);
+    }
+
+    void await_resume() const {}
+
+  private:
+    static void execute(DispatchRequest& request) {
+      auto resume = static_cast<MainThreadAwaiter&>(request).resume_;
+      resume();
+    }
+
+    static void abandon(DispatchRequest& request) {
+      auto resume = static_cast<MainThreadAwaiter&>(request).resume_;
+      resume.destroy();
+    }
+
+    const AppHandler* app_;
+    ResumeHandle resume_;
+  };
+
+  /**
+   * @brief Awaiter resuming the coroutine on a thread pool worker. Returned by App::background().
+   *
+   * If the pool queue is full, the coroutine goes on running on the awaiting thread.
+   */
+  class BackgroundAwaiter {
+  public:
+    explicit BackgroundAwaiter(ThreadPool& pool) : pool_(&pool) {}
+
+    [[nodiscard]] bool await_ready() const { return false; }
+
+    template <typename Handle> void await_suspend(Handle handle) {
+      pool_->submit([resume = ResumeHandle::from(handle)] { resume(); },
+                    QueueFullPolicy::kRunInCaller);
+    }
+
+    void await_resume() const {}
+
+  private:
+    ThreadPool* pool_;
+  };
+
+  /**
+   * @brief Awaiter for a value computed asynchronously, delivered through a callback.
+   *
+   * The operation starts when the coroutine suspends, and the coroutine resumes on the thread
+   * calling the callback, the main thread for the webview operations. If the callback is never
+   * called, for instance because the webview is destroyed first, the coroutine is never resumed.
+   *
+   * @tparam Result The type of the value.
+   */
+  template <typename Result> class ResultAwaiter {
+  public:
+    using Callback = std::function<void(Result)>;
+    using Operation = std::function<void(Callback)>;
+
+    explicit ResultAwaiter(Operation operation) : operation_(std::move(operation)) {}
+
+    [[nodiscard]] bool await_ready() const { return false; }
+
+    template <typename Handle> void await_suspend(Handle handle) {
+      // The callback may resume the coroutine and destroy this awaiter before the operation
+      // returns, so the operation must not be run from a member
+      auto operation = std::move(operation_);
+      operation([this, resume = ResumeHandle::from(handle)](Result result) {
+        result_.emplace(std::move(result));
+        resume();
+      });
+    }
+
+    Result await_resume() { return std::move(*result_); }
+
+  private:
+    Operation operation_;
+    std::optional<Result> result_;
+  };
+
+}  // namespace deskgui
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#  include <coroutine>
+#  include <exception>
+
+namespace deskgui {
+
+  /**
+   * @brief Return type of fire-and-forget coroutines.
+   *
+   * The coroutine starts running immediately and frees its frame once it completes. Exceptions
+   * escaping it terminate the program.
+   *
+   * Example:
+   * @code{.cpp}
+   * DetachedTask refreshTitle(App& app, Window* window) {
+   *   co_await app.background();
+   *   auto title = fetchTitle();
+   *   co_await app.mainThread();
+   *   window->setTitle(title);
+   * }
+   * @endcode
+   */
+  struct DetachedTask {
+    struct promise_type {
+      DetachedTask get_return_object() noexcept { return {}; }
+      std::suspend_never initial_suspend() noexcept { return {}; }
+      std::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() noexcept {}
+      void unhandled_exception() noexcept { std::terminate(); }
+    };
+  };
+
+}  // namespace deskgui
+#endif
@@ -0,0 +1,120 @@
+/**
+ * deskgui - A powerful and flexible C++ library to create web-based desktop applications.
+ *
+ * Copyright (c) 2023 deskgui
+ * MIT License
+ */
+
+#pragma once
+
+#include <deskgui/app_handler.h>
+#include <deskgui/inplace_function.h>
+#include <deskgui/thread_pool.h>
+
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace deskgui {
+
+  // Continuation of a BackgroundTask, receiving its result unless the work returns void
+  template <typename Result> struct BackgroundContinuation {
+    using type = std::function<void(Result)>;
+  };
+
+  template <> struct BackgroundContinuation<void> {
+    using type = std::function<void()>;
+  };
+
+  // Receives the exception thrown by the work of a BackgroundTask, on the main thread
+  using BackgroundErrorHandler = std::function<void(std::exception_ptr)>;
+
+  /**
+   * @brief Work to run on a thread pool worker, with an optional continuation on the main thread.
+   * Returned by App::runInBackground().
+   *
+   * The work is submitted when then() is called, or when the task is destroyed without a
+   * continuation, so the continuation can never miss the result. If the pool queue is full, the
+   * work runs on the calling thread. The work only needs to be movable. If it throws, the
+   * continuation does not run and the exception is posted to the error handler given to then(),
+   * or discarded if there is none.
+   *
+   * Example:
+   * @code{.cpp}
+   * app.runInBackground([] { return loadData(); })
+   *     .then([window](Data data) { window->setTitle(data.title); },
+   *           [](std::exception_ptr error) { reportError(error); });
+   * @endcode
+   *
+   * @tparam Result The type returned by the work, copied to the continuation.
+   */
+  template <typename Result> class BackgroundTask {
+  public:
+    using Work = InplaceFunction<Result()>;
+    using Continuation = typename BackgroundContinuation<Result>::type;
+
+    BackgroundTask(ThreadPool& pool, const AppHandler& app, Work work)
+        : pool_(&pool), app_(&app), work_(std::move(work)) {}
+
+    ~BackgroundTask() {
+      if (work_) {
+        submit(nullptr, nullptr);
+      }
+    }
+
+    BackgroundTask(BackgroundTask&& other) noexcept
+        : pool_(other.pool_), app_(other.app_), work_(std::move(other.work_)) {}
+
+    BackgroundTask(const BackgroundTask&) = delete;
+    BackgroundTask& operator=(const BackgroundTask&) = delete;
+    BackgroundTask& operator=(BackgroundTask&&) = delete;
+
+    /**
+     * @brief Submits the work, posting the continuation to the main thread once it completes.
+     *
+     * @param continuation The function receiving the result on the main thread.
+     * @param onError The function receiving the exception thrown by the work on the main thread.
+     */
+    void then(Continuation continuation, BackgroundErrorHandler onError = nullptr) && {
+      submit(std::move(continuation), std::move(onError));
+    }
+
+  private:
+    void submit(Continuation continuation, BackgroundErrorHandler onError) {
+      // Exceptions are caught here rather than by the pool, so they are also handled when the
+      // work runs on the calling thread, possibly from the destructor
+      pool_->submit(
+          [app = app_, work = std::move(work_), continuation = std::move(continuation),
+           onError = std::move(onError)]() mutable {
+            try {
+              if constexpr (std::is_void_v<Result>) {
+                work();
+                if (continuation) {
+                  app->postOnMainThread(std::move(continuation));
+                }
+              } else {
+                auto result = work();
+                if (continuation) {
+                  app->postOnMainThread([continuation = std::move(continuation),
+                                         result = std::move(result)]() mutable {
+                    continuation(std::move(result));
+                  });
+                }
+              }
+            } catch (...) {
+              if (onError) {
+                app->postOnMainThread([onError = std::move(onError),
+                                       error = std::current_exception()] { onError(error); });
+              }
+            }
+          },
+          QueueFullPolicy::kRunInCaller);
+    }
+
+    ThreadPool* pool_;
+    const AppHandler* app_;
+    Work work_;
+  };
+
+}  // namespace deskgui
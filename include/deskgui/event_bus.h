@@ -8,74 +8,721 @@
 #pragma once
 
 #include <deskgui/events.h>
+#include <deskgui/inplace_function.h>
+#include <deskgui/thread_pool.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
 #include <functional>
+#include <limits>
+#include <map>
+#include <memory>
 #include <mutex>
-#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
-#include <typeindex>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace deskgui {
 
+  /**
+   * @brief How EventBus::drain() delivers the events posted with EventBus::post().
+   */
+  enum class PostPolicy {
+    kDeliverAll,  // Every posted event, in post order
+    kLatestWins,  // Only the last event posted since the previous drain
+    kCountOnly,   // A single event built from the number of posts since the previous drain
+  };
+
+  /**
+   * @brief Post policy of an event type. Specialize it to change the policy of an event.
+   *
+   * kCountOnly events are posted without arguments and must be constructible from std::size_t.
+   */
+  template <class EventType> struct EventPostPolicy {
+    static constexpr PostPolicy value = PostPolicy::kDeliverAll;
+  };
+
+  // Resizes come in bursts and only the final size matters
+  template <> struct EventPostPolicy<event::WindowResize> {
+    static constexpr PostPolicy value = PostPolicy::kLatestWins;
+  };
+
+  /**
+   * @brief Whether emitting an event stops at the first listener that cancels it.
+   *
+   * Specialize it to opt an event type in; the type must then provide isCancelled(), as the
+   * cancellable events derived from event::Event do.
+   */
+  template <class EventType> struct EventStopsOnCancel : std::false_type {};
+
+  // Cancelling these events vetoes the action they announce, so lower-priority listeners are not
+  // told about an action that won't happen
+  template <> struct EventStopsOnCancel<event::WindowShow> : std::true_type {};
+  template <> struct EventStopsOnCancel<event::WindowClose> : std::true_type {};
+  template <> struct EventStopsOnCancel<event::WebviewNavigationStarting> : std::true_type {};
+  template <> struct EventStopsOnCancel<event::WebviewNavigationStartingView> : std::true_type {};
+  template <> struct EventStopsOnCancel<event::WebviewFrameNavigationStarting> : std::true_type {};
+  template <> struct EventStopsOnCancel<event::WebviewWindowRequested> : std::true_type {};
+
+  /**
+   * @class EventBus
+   * @brief Thread-safe publish/subscribe bus used by windows and webviews to notify events.
+   *
+   * Listeners are stored in an immutable snapshot that is replaced as a whole (copy-on-write)
+   * whenever a listener is connected or disconnected. emit() registers as a reader of the slot
+   * with an atomic counter and loads the current snapshot from an atomic pointer, so it takes no
+   * lock, never waits for writers, and listeners may connect or disconnect from inside a callback.
+   * An emit that is already in flight keeps delivering to the snapshot it started with: replaced
+   * snapshots are freed by a later writer, once the emits that may still read them are done.
+   *
+   * Every event type is assigned a process-wide slot index the first time a listener is connected
+   * to it, so finding the listeners of a type is an array access instead of a hash lookup. Types
+   * that are only emitted, counted or posted don't take an index. At most kMaxEventTypes distinct
+   * event types can be connected.
+   *
+   * Within a slot, listeners are kept in dense blocks of kBlockSize entries, ordered by priority
+   * (highest first) and then by connect order, and are invoked in that order. Event types that opt
+   * in with EventStopsOnCancel are not delivered to the remaining listeners once cancelled. A
+   * mutation only rebuilds the blocks it touches. Listener ids are
+   * generation-tagged handles, so disconnect finds its entry in constant time and a stale id never
+   * removes a newer listener.
+   *
+   * Callables are stored in an InplaceFunction with kListenerCapacity bytes of inline storage, so
+   * they only need to be movable, captures that fit are not allocated separately, and invoking a
+   * listener is a single indirect call.
+   *
+   * Listeners may also be connected with a key. Keyed listeners are indexed by that key and only
+   * receive the events emitted with the same key, after the listeners connected without one.
+   *
+   * Besides emit(), events can be post()ed from any thread to a lock-free queue. They are delivered
+   * by drain(), which the application runs on the main thread once per loop iteration, and are
+   * coalesced according to the EventPostPolicy of their type.
+   *
+   * Listeners connected with connectAsync() receive a copy of the event on ThreadPool::shared()
+   * instead of running inside emit().
+   */
   class EventBus {
   public:
-    // Generic connect for any callable (lambda, functor, std::function)
+    static constexpr std::size_t kMaxEventTypes = 64;
+    static constexpr std::size_t kBlockSize = 64;
+    static constexpr std::size_t kListenerCapacity = 64;
+
+    EventBus() = default;
+
+    ~EventBus() {
+      for (auto& slot : slots_) {
+        delete slot.latest.load(std::memory_order_acquire);
+      }
+      deleteAll(posted_.exchange(nullptr, std::memory_order_acquire));
+      deleteAll(undelivered_);
+    }
+
+    // Generic connect for any callable (lambda, functor, std::function). Listeners with a higher
+    // priority are invoked first.
+    template <class EventType, typename Callable>
+    [[maybe_unused]] UniqueId connect(Callable&& listener, int priority = 0) {
+      return connect<EventType>(std::string_view{}, std::forward<Callable>(listener), priority);
+    }
+
+    // Connects a listener that only receives the events emitted with the same key. An empty key
+    // connects a listener that receives every event.
     template <class EventType, typename Callable>
-    [[maybe_unused]] UniqueId connect(Callable&& listener) {
+    [[maybe_unused]] UniqueId connect(std::string_view key, Callable&& listener, int priority = 0) {
       std::unique_lock lock(mutex_);
 
-      return connectHelper<EventType>([cb = std::forward<Callable>(listener)](void* event) mutable {
-        callHelper(cb, static_cast<EventType*>(event));
+      return connectHelper<EventType>(
+          key, priority, [cb = std::forward<Callable>(listener)](void* event) mutable {
+            callHelper(cb, static_cast<EventType*>(event));
+          });
+    }
+
+    // Connects a listener that runs on ThreadPool::shared() with a copy of each event, so that slow
+    // listeners don't hold up the emitter. The listener may run concurrently with itself, and
+    // cancelling the copy has no effect on the emitter. It never runs inside emit(): events
+    // emitted while the pool queue is full are dropped for it, and its exceptions are discarded.
+    template <class EventType, typename Callable>
+    [[maybe_unused]] UniqueId connectAsync(Callable&& listener) {
+      return connectAsync<EventType>(std::string_view{}, std::forward<Callable>(listener));
+    }
+
+    template <class EventType, typename Callable>
+    [[maybe_unused]] UniqueId connectAsync(std::string_view key, Callable&& listener) {
+      static_assert(std::is_copy_constructible_v<EventType>,
+                    "Asynchronous listeners need a copyable event, views are only valid in emit");
+
+      std::unique_lock lock(mutex_);
+
+      // Shared with the queued tasks, which may outlive the connection
+      auto cb = std::make_shared<std::decay_t<Callable>>(std::forward<Callable>(listener));
+      return connectHelper<EventType>(key, 0, [cb = std::move(cb)](void* event) {
+        auto copy = std::make_shared<const EventType>(*static_cast<const EventType*>(event));
+        ThreadPool::shared().submit([cb, copy] { callHelper(*cb, copy.get()); },
+                                    QueueFullPolicy::kDrop);
       });
     }
 
     template <typename EventType> void disconnect(UniqueId id) {
       std::unique_lock lock(mutex_);
 
-      const auto typeId = std::type_index(typeid(EventType));
-      const auto it = connections_.find(typeId);
-      if (it != connections_.end()) {
-        it->second.erase(id);
+      auto* slot = findSlot<EventType>();
+      if (!slot || !slot->registry) {
+        return;
       }
+
+      auto& registry = *slot->registry;
+      const auto index = id & kHandleMask;
+      if (index >= registry.handles.size() || !registry.handles[index].connected
+          || registry.handles[index].generation != id >> kHandleBits) {
+        return;
+      }
+
+      auto& handle = registry.handles[index];
+      auto& channel = *handle.channel;
+      channel.listeners[handle.position].listener = nullptr;
+      ++channel.disconnected;
+      --registry.size;
+      const auto block = handle.position / kBlockSize;
+
+      handle.connected = false;
+      handle.generation = (handle.generation + 1) & kHandleMask;
+      registry.freeHandles.push_back(index);
+
+      if (channel.disconnected * 2 > channel.listeners.size()) {
+        compact(registry, channel);
+      } else {
+        rebuildBlock(channel, block);
+      }
+      channel.published = std::make_shared<const Blocks>(channel.blocks);
+      publish(*slot);
     }
 
+    // Invokes the listeners connected without a key and, if key is not empty, the ones connected
+    // with that key
     template <class EventType, typename = std::enable_if_t<!std::is_pointer_v<EventType>>>
-    void emit(EventType&& event) {
-      std::shared_lock lock(mutex_);
-
-      const auto typeId = std::type_index(typeid(EventType));
-      const auto it = connections_.find(typeId);
-      if (it != connections_.end()) {
-        for (const auto& [key, callback] : it->second) {
-          callback(&event);
-        }
+    void emit(EventType&& event, std::string_view key = {}) {
+      auto* slot = findSlot<EventType>();
+      if (!slot || slot->size.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+
+      const SnapshotReader reader(*slot);
+      if (const auto* snapshot = reader.snapshot()) {
+        deliver(*snapshot, event, key);
       }
     }
 
     template <class EventType> [[nodiscard]] std::size_t count() const {
-      std::shared_lock lock(mutex_);
-      const auto typeId = std::type_index(typeid(EventType));
-      const auto it = connections_.find(typeId);
-      return (it != connections_.end()) ? it->second.size() : 0;
+      const auto* slot = findSlot<EventType>();
+      return slot ? slot->size.load(std::memory_order_acquire) : 0;
+    }
+
+    // Cheap check that lets emitters skip building events nobody listens to
+    template <class EventType> [[nodiscard]] bool hasListeners() const {
+      return count<EventType>() != 0;
+    }
+
+    // Builds the event with factory() and emits it, only if a listener would receive it
+    template <class EventType, typename Factory>
+    void emitLazy(Factory&& factory, std::string_view key = {}) {
+      auto* slot = findSlot<EventType>();
+      if (!slot || slot->size.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+
+      const SnapshotReader reader(*slot);
+      if (const auto* snapshot = reader.snapshot(); snapshot && snapshot->receives(key)) {
+        EventType event = std::forward<Factory>(factory)();
+        deliver(*snapshot, event, key);
+      }
+    }
+
+    // Queues an event built from args, to be delivered by the next drain(). Events of a type that
+    // no listener was ever connected to are dropped.
+    template <class EventType, typename... Args> void post(Args&&... args) {
+      auto* slot = findSlot<EventType>();
+      if (!slot) {
+        return;
+      }
+
+      constexpr auto policy = EventPostPolicy<EventType>::value;
+      if constexpr (policy == PostPolicy::kDeliverAll) {
+        enqueue(new PostedEvent<EventType>(std::forward<Args>(args)...));
+      } else if constexpr (policy == PostPolicy::kLatestWins) {
+        // The latest event replaces the pending one, which was not delivered yet
+        auto* event = new PostedEvent<EventType>(std::forward<Args>(args)...);
+        if (auto* pending = slot->latest.exchange(event, std::memory_order_acq_rel)) {
+          delete pending;
+        } else {
+          enqueue(new PostedLatest<EventType>());
+        }
+      } else {
+        static_assert(sizeof...(Args) == 0, "kCountOnly events are posted without arguments");
+        static_assert(std::is_constructible_v<EventType, std::size_t>,
+                      "kCountOnly events must be constructible from the number of posts");
+        if (slot->posted.fetch_add(1, std::memory_order_acq_rel) == 0) {
+          enqueue(new PostedCount<EventType>());
+        }
+      }
+    }
+
+    // Delivers the events posted since the last drain, in post order. Only one thread may drain.
+    // If a listener throws, the remaining events are kept for the next drain.
+    void drain() {
+      // The post queue is a stack, reversed here to keep post order
+      Posted* posted = nullptr;
+      for (auto* next = posted_.exchange(nullptr, std::memory_order_acquire); next;) {
+        auto* current = next;
+        next = current->next;
+        current->next = posted;
+        posted = current;
+      }
+
+      auto** tail = &undelivered_;
+      while (*tail) {
+        tail = &(*tail)->next;
+      }
+      *tail = posted;
+
+      while (undelivered_) {
+        std::unique_ptr<Posted> current(undelivered_);
+        undelivered_ = current->next;
+        current->deliver(*this);
+      }
+    }
+
+    [[nodiscard]] bool hasPosted() const {
+      return posted_.load(std::memory_order_acquire) != nullptr || undelivered_ != nullptr;
+    }
+
+    // Called from post() whenever the queue stops being empty, to schedule a drain(). May be
+    // replaced while other threads post; once it returns, the previous wakeup is no longer called.
+    void setWakeup(std::function<void()> wakeup) {
+      std::lock_guard lock(wakeupMutex_);
+      wakeup_ = std::move(wakeup);
     }
 
     void clear() {
       std::unique_lock lock(mutex_);
-      connections_.clear();
+      for (auto& slot : slots_) {
+        if (!slot.registry) {
+          continue;
+        }
+
+        // Handles are kept so that ids issued before clear() stay stale
+        auto& registry = *slot.registry;
+        for (std::size_t index = 0; index < registry.handles.size(); ++index) {
+          auto& handle = registry.handles[index];
+          if (handle.connected) {
+            handle.connected = false;
+            handle.generation = (handle.generation + 1) & kHandleMask;
+            registry.freeHandles.push_back(index);
+          }
+        }
+        registry.listeners = Registry::Channel{};
+        registry.keyed.clear();
+        registry.size = 0;
+        publish(slot);
+      }
     }
 
   private:
+    using EventCallback = InplaceFunction<void(void*), kListenerCapacity>;
+
+    // A connected listener, shared by every block that contains it
+    struct Listener {
+      template <class Callback>
+      explicit Listener(Callback&& callback_) : callback(std::forward<Callback>(callback_)) {}
+
+      EventCallback callback;
+    };
+
+    // Immutable run of up to kBlockSize listeners, in connect order. Blocks hold the listeners by
+    // reference: a rebuilt block can't take them over from the one it replaces, which emits in
+    // flight may still run, and copying them instead would require copyable callables and split
+    // the state of mutable ones between blocks. Invoking through the extra pointer costs within
+    // a few percent of listeners stored by value, as the call itself dominates.
+    using Block = std::vector<std::shared_ptr<const Listener>>;
+    using Blocks = std::vector<std::shared_ptr<const Block>>;
+
+    // Immutable view of a slot handed out to emit()
+    struct Snapshot {
+      std::shared_ptr<const Blocks> listeners;  // Connected without a key
+      std::size_t size = 0;                     // Live listeners connected without a key
+      std::map<std::string, std::shared_ptr<const Blocks>, std::less<>> keyed;
+
+      [[nodiscard]] bool receives(std::string_view key) const {
+        return size != 0 || (!key.empty() && keyed.find(key) != keyed.end());
+      }
+    };
+
+    // Ids are split in a handle index (low bits) and a generation (high bits)
+    static constexpr auto kHandleBits = std::numeric_limits<UniqueId>::digits / 2;
+    static constexpr UniqueId kHandleMask = (UniqueId{1} << kHandleBits) - 1;
+
+    // Writer side of a slot, only accessed with mutex_ held
+    struct Registry {
+      struct Entry {
+        std::shared_ptr<const Listener> listener;  // nullptr once disconnected
+        std::size_t handle;
+        int priority;
+      };
+
+      // Listeners sharing a key, by priority then connect order, and compacted lazily
+      struct Channel {
+        std::vector<Entry> listeners;
+        std::size_t disconnected = 0;
+
+        std::vector<std::shared_ptr<const Block>> blocks;  // listeners, kBlockSize at a time
+        std::shared_ptr<const Blocks> published = std::make_shared<const Blocks>();
+      };
+
+      struct Handle {
+        UniqueId generation = 0;
+        Channel* channel = nullptr;
+        std::size_t position = 0;  // Index in channel->listeners
+        bool connected = false;
+      };
+
+      std::vector<Handle> handles;
+      std::vector<std::size_t> freeHandles;
+
+      Channel listeners;  // Connected without a key
+      // Node based, so the Channel* kept by handles stay valid
+      std::map<std::string, Channel, std::less<>> keyed;
+      std::size_t size = 0;
+    };
+
+    // Node of the post queue, delivered and destroyed by drain()
+    struct Posted {
+      virtual ~Posted() = default;
+      virtual void deliver(EventBus& bus) = 0;
+
+      Posted* next = nullptr;
+    };
+
+    struct Slot {
+      std::atomic<std::size_t> size{0};
+      std::atomic<const Snapshot*> snapshot{nullptr};  // Read by emit() without locking
+      std::unique_ptr<Registry> registry;
+
+      // Emits in flight are counted by the epoch they started in. Writers only move to the other
+      // epoch once its emits are done, so emits from before the last move can't be older.
+      std::atomic<std::size_t> epoch{0};
+      std::array<std::atomic<std::size_t>, 2> readers{};
+
+      // Writer side, only accessed with mutex_ held: the published snapshot and the replaced ones
+      // by the epoch they were replaced in, which emits in flight may still read
+      std::unique_ptr<const Snapshot> current;
+      std::array<std::vector<std::unique_ptr<const Snapshot>>, 2> retired;
+
+      std::atomic<Posted*> latest{nullptr};  // Pending kLatestWins event
+      std::atomic<std::size_t> posted{0};    // Pending kCountOnly posts
+    };
+
+    // Registers an emit as a reader of a slot, so the snapshot it loads is not freed under it
+    class SnapshotReader {
+    public:
+      explicit SnapshotReader(Slot& slot)
+          : slot_(slot), epoch_(slot.epoch.load(std::memory_order_seq_cst)) {
+        slot_.readers[epoch_].fetch_add(1, std::memory_order_seq_cst);
+      }
+      ~SnapshotReader() { slot_.readers[epoch_].fetch_sub(1, std::memory_order_release); }
+
+      SnapshotReader(const SnapshotReader&) = delete;
+      SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+      // Loaded after registering, so a writer replacing it afterwards sees the reader
+      [[nodiscard]] const Snapshot* snapshot() const {
+        return slot_.snapshot.load(std::memory_order_seq_cst);
+      }
+
+    private:
+      Slot& slot_;
+      std::size_t epoch_;
+    };
+
+    template <class EventType> struct PostedEvent final : Posted {
+      template <typename... Args>
+      explicit PostedEvent(Args&&... args) : event{std::forward<Args>(args)...} {}
+
+      void deliver(EventBus& bus) override { bus.emit(event); }
+
+      EventType event;
+    };
+
+    // Queued once per drain, delivers whatever event is the latest when it runs
+    template <class EventType> struct PostedLatest final : Posted {
+      void deliver(EventBus& bus) override {
+        std::unique_ptr<Posted> latest(
+            bus.findSlot<EventType>()->latest.exchange(nullptr, std::memory_order_acq_rel));
+        if (latest) {
+          latest->deliver(bus);
+        }
+      }
+    };
+
+    template <class EventType> struct PostedCount final : Posted {
+      void deliver(EventBus& bus) override {
+        const auto count = bus.findSlot<EventType>()->posted.exchange(0, std::memory_order_acq_rel);
+        if (count != 0) {
+          EventType event(count);
+          bus.emit(event);
+        }
+      }
+    };
+
+    // Lock-free push; wakes the consumer up when the queue was empty
+    void enqueue(Posted* node) {
+      auto* head = posted_.load(std::memory_order_relaxed);
+      do {
+        node->next = head;
+      } while (!posted_.compare_exchange_weak(head, node, std::memory_order_release,
+                                              std::memory_order_relaxed));
+
+      // node may already be drained here, only the previous head is looked at. The lock is only
+      // taken once per burst of posts.
+      if (!head) {
+        std::lock_guard lock(wakeupMutex_);
+        if (wakeup_) {
+          wakeup_();
+        }
+      }
+    }
+
+    static void deleteAll(Posted* node) {
+      while (node) {
+        delete std::exchange(node, node->next);
+      }
+    }
+
     template <class EventType, class ListenerCallback>
-    UniqueId connectHelper(ListenerCallback&& listener) {
-      const auto id = EventListenerId::newId();
-      const auto typeId = std::type_index(typeid(EventType));
+    UniqueId connectHelper(std::string_view key, int priority, ListenerCallback&& listener) {
+      auto* slot = assignSlot<EventType>();
+      if (!slot) {
+        throw std::length_error("EventBus: too many event types");
+      }
+      if (!slot->registry) {
+        slot->registry = std::make_unique<Registry>();
+      }
+
+      auto& registry = *slot->registry;
+      auto index = registry.handles.size();
+      if (!registry.freeHandles.empty()) {
+        index = registry.freeHandles.back();
+        registry.freeHandles.pop_back();
+      } else if (index > kHandleMask) {
+        throw std::length_error("EventBus: too many listeners");
+      } else {
+        registry.handles.emplace_back();
+      }
+
+      auto& channel = key.empty() ? registry.listeners : findChannel(registry, key);
+
+      // After every listener with the same or a higher priority, usually at the end
+      const auto position = static_cast<std::size_t>(
+          std::upper_bound(channel.listeners.begin(), channel.listeners.end(), priority,
+                           [](int value, const Registry::Entry& entry) {
+                             return value > entry.priority;
+                           })
+          - channel.listeners.begin());
+
+      auto& handle = registry.handles[index];
+      handle.channel = &channel;
+      handle.position = position;
+      handle.connected = true;
+
+      channel.listeners.insert(
+          channel.listeners.begin() + position,
+          {std::make_shared<const Listener>(std::forward<ListenerCallback>(listener)), index,
+           priority});
+      ++registry.size;
+
+      // The handles of disconnected entries may already be reused by other listeners
+      for (auto next = position + 1; next < channel.listeners.size(); ++next) {
+        if (channel.listeners[next].listener) {
+          registry.handles[channel.listeners[next].handle].position = next;
+        }
+      }
+      const auto blocks = (channel.listeners.size() + kBlockSize - 1) / kBlockSize;
+      for (auto block = position / kBlockSize; block < blocks; ++block) {
+        rebuildBlock(channel, block);
+      }
+      channel.published = std::make_shared<const Blocks>(channel.blocks);
+      publish(*slot);
+
+      return (handle.generation << kHandleBits) | index;
+    }
+
+    static Registry::Channel& findChannel(Registry& registry, std::string_view key) {
+      auto it = registry.keyed.find(key);
+      if (it == registry.keyed.end()) {
+        it = registry.keyed.try_emplace(std::string(key)).first;
+      }
+      return it->second;
+    }
+
+    // Rebuilds the immutable block holding listeners [block * kBlockSize, (block + 1) * kBlockSize).
+    // The blocks are published by the caller, once every touched block is rebuilt.
+    static void rebuildBlock(Registry::Channel& channel, std::size_t block) {
+      const auto begin = block * kBlockSize;
+      const auto end = std::min(channel.listeners.size(), begin + kBlockSize);
+
+      auto listeners = std::make_shared<Block>();
+      listeners->reserve(end - begin);
+      for (auto position = begin; position < end; ++position) {
+        if (channel.listeners[position].listener) {
+          listeners->push_back(channel.listeners[position].listener);
+        }
+      }
 
-      auto& callbacks_ = connections_[typeId];
-      callbacks_.try_emplace(id, std::forward<ListenerCallback>(listener));
+      if (block < channel.blocks.size()) {
+        channel.blocks[block] = std::move(listeners);
+      } else {
+        channel.blocks.push_back(std::move(listeners));
+      }
+    }
+
+    // Drops disconnected entries once they are the majority, keeping connect order
+    static void compact(Registry& registry, Registry::Channel& channel) {
+      const auto disconnected
+          = std::remove_if(channel.listeners.begin(), channel.listeners.end(),
+                           [](const Registry::Entry& entry) { return !entry.listener; });
+      channel.listeners.erase(disconnected, channel.listeners.end());
+      channel.disconnected = 0;
+
+      for (std::size_t position = 0; position < channel.listeners.size(); ++position) {
+        registry.handles[channel.listeners[position].handle].position = position;
+      }
+
+      const auto blocks = (channel.listeners.size() + kBlockSize - 1) / kBlockSize;
+      channel.blocks.resize(blocks);
+      for (std::size_t block = 0; block < blocks; ++block) {
+        rebuildBlock(channel, block);
+      }
+    }
+
+    // Replaces the snapshot of a slot with the channels of its registry. Requires mutex_.
+    static void publish(Slot& slot) {
+      auto& registry = *slot.registry;
+
+      auto snapshot = std::make_unique<Snapshot>();
+      snapshot->listeners = registry.listeners.published;
+      snapshot->size = registry.listeners.listeners.size() - registry.listeners.disconnected;
+      for (auto it = registry.keyed.begin(); it != registry.keyed.end();) {
+        if (it->second.listeners.empty()) {
+          it = registry.keyed.erase(it);
+        } else {
+          snapshot->keyed.emplace_hint(snapshot->keyed.end(), it->first, it->second.published);
+          ++it;
+        }
+      }
+
+      const auto epoch = slot.epoch.load(std::memory_order_relaxed);
+      if (slot.current) {
+        slot.retired[epoch].push_back(std::move(slot.current));
+      }
+      slot.current = std::move(snapshot);
+      slot.snapshot.store(slot.current.get(), std::memory_order_seq_cst);
+      slot.size.store(registry.size, std::memory_order_release);
+
+      // Once the emits of the other epoch are done, nothing reads the snapshots replaced in it:
+      // they started before the move to this epoch, and the later ones load newer snapshots. New
+      // emits then move to it, and the current epoch drains in turn.
+      const auto other = epoch ^ 1;
+      if (slot.readers[other].load(std::memory_order_seq_cst) == 0) {
+        slot.retired[other].clear();
+        slot.epoch.store(other, std::memory_order_seq_cst);
+      }
+    }
+
+    // Returns false if stopped() interrupted the delivery
+    template <class Stopped>
+    static bool invoke(const Blocks& blocks, void* event, const Stopped& stopped) {
+      for (const auto& block : blocks) {
+        for (const auto& listener : *block) {
+          listener->callback(event);
+          if (stopped()) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    template <class Stopped> static void invoke(const Snapshot& snapshot, void* event,
+                                                std::string_view key, const Stopped& stopped) {
+      if (!invoke(*snapshot.listeners, event, stopped) || key.empty()) {
+        return;
+      }
+      if (const auto it = snapshot.keyed.find(key); it != snapshot.keyed.end()) {
+        invoke(*it->second, event, stopped);
+      }
+    }
+
+    template <class EventType>
+    static void deliver(const Snapshot& snapshot, EventType& event, std::string_view key) {
+      if constexpr (EventStopsOnCancel<std::remove_cv_t<EventType>>::value) {
+        invoke(snapshot, &event, key, [&event] { return event.isCancelled(); });
+      } else {
+        invoke(snapshot, &event, key, [] { return false; });
+      }
+    }
+
+    static constexpr auto kNoSlot = std::numeric_limits<std::size_t>::max();
+
+    // Index of EventType in slots_, kNoSlot until a listener is first connected to the type in
+    // this process
+    template <class EventType> static std::atomic<std::size_t>& slotIndex() {
+      static std::atomic<std::size_t> index{kNoSlot};
+      return index;
+    }
+
+    template <class EventType> Slot* assignSlot() {
+      using Type = std::remove_cv_t<std::remove_reference_t<EventType>>;
+      auto& index = slotIndex<Type>();
+      if (const auto assigned = index.load(std::memory_order_acquire); assigned != kNoSlot) {
+        return assigned < kMaxEventTypes ? &slots_[assigned] : nullptr;
+      }
+
+      // Buses connecting the same type concurrently must agree on its index
+      std::lock_guard lock(slotIndexMutex());
+      if (index.load(std::memory_order_relaxed) == kNoSlot) {
+        index.store(nextSlotIndex(), std::memory_order_release);
+      }
+      const auto assigned = index.load(std::memory_order_relaxed);
+      return assigned < kMaxEventTypes ? &slots_[assigned] : nullptr;
+    }
+
+    static std::mutex& slotIndexMutex() {
+      static std::mutex mutex;
+      return mutex;
+    }
+
+    // Requires slotIndexMutex()
+    static std::size_t nextSlotIndex() {
+      static std::size_t next = 0;
+      assert(next < kMaxEventTypes && "EventBus: too many event types");
+      return next++;
+    }
+
+    template <class EventType> Slot* findSlot() {
+      const auto index
+          = slotIndex<std::remove_cv_t<std::remove_reference_t<EventType>>>().load(
+              std::memory_order_acquire);
+      return index < kMaxEventTypes ? &slots_[index] : nullptr;
+    }
 
-      return id;
+    template <class EventType> const Slot* findSlot() const {
+      const auto index
+          = slotIndex<std::remove_cv_t<std::remove_reference_t<EventType>>>().load(
+              std::memory_order_acquire);
+      return index < kMaxEventTypes ? &slots_[index] : nullptr;
     }
 
     // Detects whether Callable wants EventType& or nothing
@@ -89,13 +736,15 @@ namespace deskgui {
       cb();  // callable expects no arguments
     }
 
-    mutable std::shared_mutex mutex_;
+    // Serializes writers; emits only go through the atomics of each slot
+    std::mutex mutex_;
 
-    using EventCallback = std::function<void(void*)>;
-    using Connections = std::unordered_map<UniqueId, EventCallback>;
-    using EventConnections = std::unordered_map<std::type_index, Connections>;
+    std::array<Slot, kMaxEventTypes> slots_;
 
-    EventConnections connections_;
+    std::atomic<Posted*> posted_{nullptr};  // Stack of posted events, newest first
+    Posted* undelivered_ = nullptr;         // Drained but not delivered yet, oldest first
+    std::mutex wakeupMutex_;                // Guards wakeup_, set on the main thread
+    std::function<void()> wakeup_;
   };
 
 }  // namespace deskgui
@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 
 namespace deskgui::event {
 
@@ -32,9 +33,12 @@ namespace deskgui::event {
     bool isCancelled() const { return cancelled_; }
     bool isCancellable() const { return cancellable_; }
 
-    Event(const Event& other) = delete;
     Event& operator=(const Event& other) = delete;
 
+  protected:
+    // Events are only copied to hand them to asynchronous listeners
+    Event(const Event& other) = default;
+
   private:
     bool cancelled_ = false;
     bool cancellable_;
@@ -85,6 +89,21 @@ namespace deskgui::event {
     const std::string message;
   };
 
+  /**
+   * @brief Non-owning variant of WebviewOnMessage.
+   *
+   * Carries a view of the message buffer owned by the native layer, so listeners can read
+   * large payloads without the copy made for WebviewOnMessage. The view is only valid while
+   * listeners are being invoked; copy it to keep it.
+   */
+  struct WebviewOnMessageView : Event {
+    explicit WebviewOnMessageView(std::string_view msg) : Event(true), message(msg) {}
+    const std::string_view message;
+
+    // The view would dangle in an asynchronous listener
+    WebviewOnMessageView(const WebviewOnMessageView&) = delete;
+  };
+
   /**
    * @brief Represents the start of a webview navigation.
    *
@@ -96,6 +115,20 @@ namespace deskgui::event {
     const std::string url;
   };
 
+  /**
+   * @brief Non-owning variant of WebviewNavigationStarting.
+   *
+   * The URL view is only valid while listeners are being invoked. Cancelling this event
+   * cancels the navigation as well.
+   */
+  struct WebviewNavigationStartingView : Event {
+    explicit WebviewNavigationStartingView(std::string_view urlArg) : Event(true), url(urlArg) {}
+    const std::string_view url;
+
+    // The view would dangle in an asynchronous listener
+    WebviewNavigationStartingView(const WebviewNavigationStartingView&) = delete;
+  };
+
   /**
    * @brief Represents the start of navigation within a webview frame.
    *
@@ -118,6 +151,19 @@ namespace deskgui::event {
     const std::string source;  // The new source URL of the webview.
   };
 
+  /**
+   * @brief Non-owning variant of WebviewSourceChanged.
+   *
+   * The source view is only valid while listeners are being invoked.
+   */
+  struct WebviewSourceChangedView : Event {
+    explicit WebviewSourceChangedView(std::string_view src) : Event(false), source(src) {}
+    const std::string_view source;  // The new source URL of the webview.
+
+    // The view would dangle in an asynchronous listener
+    WebviewSourceChangedView(const WebviewSourceChangedView&) = delete;
+  };
+
   /**
    * @brief Represents the content loading state of a webview.
    *
@@ -0,0 +1,136 @@
+/**
+ * deskgui - A powerful and flexible C++ library to create web-based desktop applications.
+ *
+ * Copyright (c) 2023 deskgui
+ * MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace deskgui {
+
+  template <typename Signature, std::size_t Capacity = 64> class InplaceFunction;
+
+  /**
+   * @class InplaceFunction
+   * @brief Move-only, type-erased callable that stores small targets inline.
+   *
+   * Targets of up to Capacity bytes with fundamental alignment are constructed inside the object
+   * itself, so wrapping them never allocates. Larger targets are moved to the heap. Unlike
+   * std::function, the target only needs to be move constructible, and calling it is a single
+   * indirect call.
+   *
+   * @tparam R The return type of the callable.
+   * @tparam Args The argument types of the callable.
+   * @tparam Capacity Size in bytes of the inline buffer.
+   */
+  template <typename R, typename... Args, std::size_t Capacity>
+  class InplaceFunction<R(Args...), Capacity> {
+  public:
+    InplaceFunction() noexcept = default;
+
+    template <typename Callable, typename Target = std::decay_t<Callable>,
+              typename = std::enable_if_t<!std::is_same_v<Target, InplaceFunction>
+                                          && std::is_invocable_r_v<R, Target&, Args...>>>
+    InplaceFunction(Callable&& callable) {
+      if constexpr (fitsInline<Target>()) {
+        ::new (static_cast<void*>(storage_)) Target(std::forward<Callable>(callable));
+        invoke_ = &invokeInline<Target>;
+        manage_ = &manageInline<Target>;
+      } else {
+        ::new (static_cast<void*>(storage_)) Target*(new Target(std::forward<Callable>(callable)));
+        invoke_ = &invokeHeap<Target>;
+        manage_ = &manageHeap<Target>;
+      }
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept { moveFrom(other); }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+      if (this != &other) {
+        reset();
+        moveFrom(other);
+      }
+      return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction() { reset(); }
+
+    R operator()(Args... args) const {
+      return invoke_(static_cast<void*>(storage_), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+    // Whether a target of type Callable would be stored without allocating
+    template <typename Callable> static constexpr bool fitsInline() {
+      return sizeof(Callable) <= Capacity && alignof(Callable) <= alignof(std::max_align_t)
+             && std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+  private:
+    enum class Operation { kMove, kDestroy };
+
+    using Invoker = R (*)(void*, Args&&...);
+    using Manager = void (*)(Operation, void*, void*) noexcept;
+
+    template <typename Target> static R invokeInline(void* storage, Args&&... args) {
+      return (*static_cast<Target*>(storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename Target> static R invokeHeap(void* storage, Args&&... args) {
+      return (**static_cast<Target**>(storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename Target>
+    static void manageInline(Operation operation, void* dst, void* src) noexcept {
+      auto* target = static_cast<Target*>(src);
+      if (operation == Operation::kMove) {
+        ::new (dst) Target(std::move(*target));
+      }
+      target->~Target();
+    }
+
+    template <typename Target>
+    static void manageHeap(Operation operation, void* dst, void* src) noexcept {
+      auto* target = static_cast<Target**>(src);
+      if (operation == Operation::kMove) {
+        ::new (dst) Target*(*target);
+      } else {
+        delete *target;
+      }
+    }
+
+    void moveFrom(InplaceFunction& other) noexcept {
+      if (other.manage_) {
+        other.manage_(Operation::kMove, storage_, other.storage_);
+      }
+      invoke_ = std::exchange(other.invoke_, nullptr);
+      manage_ = std::exchange(other.manage_, nullptr);
+    }
+
+    void reset() noexcept {
+      if (manage_) {
+        manage_(Operation::kDestroy, nullptr, storage_);
+      }
+      invoke_ = nullptr;
+      manage_ = nullptr;
+    }
+
+    static_assert(Capacity >= sizeof(void*), "InplaceFunction capacity must hold a pointer");
+
+    // The target keeps std::function semantics: it may mutate itself through a const call
+    alignas(std::max_align_t) mutable unsigned char storage_[Capacity];
+    Invoker invoke_{nullptr};
+    Manager manage_{nullptr};
+  };
+
+}  // namespace deskgui
@@ -0,0 +1,210 @@
+/**
+ * deskgui - A powerful and flexible C++ library to create web-based desktop applications.
+ *
+ * Copyright (c) 2023 deskgui
+ * MIT License
+ */
+
+#pragma once
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace deskgui {
+
+  // Writer producing the JSON result of a typed bound function.
+  using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+
+  /**
+   * @brief Conversion of a C++ type from and to JSON, used by typed bound functions.
+   *
+   * Defined for bool, arithmetic types, std::string, std::vector and string keyed maps of
+   * convertible types. Specialize it to pass other types:
+   *
+   * @code{.cpp}
+   * template <> struct deskgui::JsonTraits<Point> {
+   *   static Point read(const rapidjson::Value& value) {
+   *     return {JsonTraits<int>::read(value["x"]), JsonTraits<int>::read(value["y"])};
+   *   }
+   *   static void write(JsonWriter& writer, const Point& point) {
+   *     writer.StartObject();
+   *     writer.Key("x");
+   *     writer.Int(point.x);
+   *     writer.Key("y");
+   *     writer.Int(point.y);
+   *     writer.EndObject();
+   *   }
+   * };
+   * @endcode
+   *
+   * read() throws std::invalid_argument if the value does not hold the type, which rejects the
+   * JavaScript call with the exception message.
+   */
+  template <typename T, typename = void> struct JsonTraits;
+
+  template <> struct JsonTraits<bool> {
+    static bool read(const rapidjson::Value& value) {
+      if (!value.IsBool()) {
+        throw std::invalid_argument("Expected a boolean");
+      }
+      return value.GetBool();
+    }
+    static void write(JsonWriter& writer, bool value) { writer.Bool(value); }
+  };
+
+  // Integers are range checked, a JavaScript number out of range or with a fraction is rejected
+  template <typename T>
+  struct JsonTraits<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+    static T read(const rapidjson::Value& value) {
+      if constexpr (std::is_signed_v<T>) {
+        if (value.IsInt64() && value.GetInt64() >= std::numeric_limits<T>::min()
+            && value.GetInt64() <= std::numeric_limits<T>::max()) {
+          return static_cast<T>(value.GetInt64());
+        }
+      } else {
+        if (value.IsUint64() && value.GetUint64() <= std::numeric_limits<T>::max()) {
+          return static_cast<T>(value.GetUint64());
+        }
+      }
+      throw std::invalid_argument("Expected an integer in range");
+    }
+    static void write(JsonWriter& writer, T value) {
+      if constexpr (std::is_signed_v<T>) {
+        writer.Int64(value);
+      } else {
+        writer.Uint64(value);
+      }
+    }
+  };
+
+  template <typename T> struct JsonTraits<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static T read(const rapidjson::Value& value) {
+      if (!value.IsNumber()) {
+        throw std::invalid_argument("Expected a number");
+      }
+      return static_cast<T>(value.GetDouble());
+    }
+    // JSON has no NaN nor infinity, the call is rejected rather than resolved with broken JSON
+    static void write(JsonWriter& writer, T value) {
+      if (!std::isfinite(value)) {
+        throw std::invalid_argument("Expected a finite number");
+      }
+      writer.Double(static_cast<double>(value));
+    }
+  };
+
+  template <> struct JsonTraits<std::string> {
+    static std::string read(const rapidjson::Value& value) {
+      if (!value.IsString()) {
+        throw std::invalid_argument("Expected a string");
+      }
+      return {value.GetString(), value.GetStringLength()};
+    }
+    static void write(JsonWriter& writer, const std::string& value) {
+      writer.String(value.data(), static_cast<rapidjson::SizeType>(value.size()));
+    }
+  };
+
+  template <typename T, typename Allocator> struct JsonTraits<std::vector<T, Allocator>> {
+    static std::vector<T, Allocator> read(const rapidjson::Value& value) {
+      if (!value.IsArray()) {
+        throw std::invalid_argument("Expected an array");
+      }
+      std::vector<T, Allocator> result;
+      result.reserve(value.Size());
+      for (auto it = value.Begin(); it != value.End(); ++it) {
+        result.push_back(JsonTraits<T>::read(*it));
+      }
+      return result;
+    }
+    static void write(JsonWriter& writer, const std::vector<T, Allocator>& value) {
+      writer.StartArray();
+      for (const auto& element : value) {
+        JsonTraits<T>::write(writer, element);
+      }
+      writer.EndArray(static_cast<rapidjson::SizeType>(value.size()));
+    }
+  };
+
+  // Maps are JavaScript objects, so their keys are strings
+  template <typename Map> struct JsonObjectTraits {
+    static Map read(const rapidjson::Value& value) {
+      if (!value.IsObject()) {
+        throw std::invalid_argument("Expected an object");
+      }
+      Map result;
+      for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it) {
+        result.emplace(std::string(it->name.GetString(), it->name.GetStringLength()),
+                       JsonTraits<typename Map::mapped_type>::read(it->value));
+      }
+      return result;
+    }
+    static void write(JsonWriter& writer, const Map& value) {
+      writer.StartObject();
+      for (const auto& [key, element] : value) {
+        writer.Key(key.data(), static_cast<rapidjson::SizeType>(key.size()));
+        JsonTraits<typename Map::mapped_type>::write(writer, element);
+      }
+      writer.EndObject(static_cast<rapidjson::SizeType>(value.size()));
+    }
+  };
+
+  template <typename T, typename Compare, typename Allocator>
+  struct JsonTraits<std::map<std::string, T, Compare, Allocator>>
+      : JsonObjectTraits<std::map<std::string, T, Compare, Allocator>> {};
+
+  template <typename T, typename Hash, typename Equal, typename Allocator>
+  struct JsonTraits<std::unordered_map<std::string, T, Hash, Equal, Allocator>>
+      : JsonObjectTraits<std::unordered_map<std::string, T, Hash, Equal, Allocator>> {};
+
+  /**
+   * @brief Calls a function of the given signature with arguments read from a JSON array, and
+   * writes its result. Functions returning void resolve to null.
+   *
+   * @throws std::invalid_argument if the arguments are not an array of the expected length and
+   * types.
+   */
+  template <typename Signature> struct JsonFunction;
+
+  template <typename Result, typename... Args> struct JsonFunction<Result(Args...)> {
+    template <typename Function>
+    static void call(Function& function, const rapidjson::Value& args, JsonWriter& writer) {
+      if (!args.IsArray() || args.Size() != sizeof...(Args)) {
+        throw std::invalid_argument("Expected " + std::to_string(sizeof...(Args)) + " arguments");
+      }
+      call(function, args, writer, std::index_sequence_for<Args...>{});
+    }
+
+  private:
+    template <typename Function, std::size_t... Index>
+    static void call(Function& function, const rapidjson::Value& args, JsonWriter& writer,
+                     std::index_sequence<Index...>) {
+      // Braced, so the arguments are read in order
+      std::tuple<std::decay_t<Args>...> values{
+          JsonTraits<std::decay_t<Args>>::read(args[static_cast<rapidjson::SizeType>(Index)])...};
+
+      if constexpr (std::is_void_v<Result>) {
+        function(std::get<Index>(std::move(values))...);
+        writer.Null();
+      } else {
+        JsonTraits<std::decay_t<Result>>::write(writer,
+                                                function(std::get<Index>(std::move(values))...));
+      }
+    }
+  };
+
+}  // namespace deskgui
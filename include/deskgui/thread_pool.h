@@ -0,0 +1,107 @@
+/**
+ * deskgui - A powerful and flexible C++ library to create web-based desktop applications.
+ *
+ * Copyright (c) 2023 deskgui
+ * MIT License
+ */
+
+#pragma once
+
+#include <deskgui/inplace_function.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace deskgui {
+
+  /**
+   * @brief What ThreadPool::submit() does when the pool already queues its capacity of tasks.
+   */
+  enum class QueueFullPolicy {
+    kRunInCaller,  // Run the task on the submitting thread, slowing the producer down
+    kDrop,         // Discard the task
+    kBlock,        // Wait until a queued task starts. Tasks submitted from a worker run inline.
+  };
+
+  /**
+   * @class ThreadPool
+   * @brief Work-stealing thread pool with a bounded number of queued tasks.
+   *
+   * Every worker owns a deque of tasks. Tasks submitted from a worker go to its own deque, tasks
+   * submitted from other threads are spread over the workers in turn. A worker runs its own tasks
+   * oldest first and, once it runs out of them, steals the newest task of another worker.
+   *
+   * At most capacity() tasks wait to be run; past that, the QueueFullPolicy given to submit()
+   * applies, so producers can't grow the memory of the pool without limit. Exceptions thrown by
+   * tasks are discarded, including when the submitting thread runs them.
+   */
+  class ThreadPool {
+  public:
+    using Task = InplaceFunction<void(), 64>;
+
+    static constexpr std::size_t kDefaultCapacity = 1024;
+
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency(),
+                        std::size_t capacity = kDefaultCapacity);
+
+    // Runs the tasks still queued and joins the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task to be run by a worker.
+     *
+     * @param task The task to run.
+     * @param policy What to do if the pool already queues capacity() tasks.
+     * @return False if the task was dropped, true otherwise.
+     */
+    bool submit(Task&& task, QueueFullPolicy policy = QueueFullPolicy::kRunInCaller);
+
+    [[nodiscard]] inline std::size_t size() const { return workers_.size(); }
+    [[nodiscard]] inline std::size_t capacity() const { return capacity_; }
+
+    // Number of tasks queued and not started yet
+    [[nodiscard]] inline std::size_t pending() const {
+      return pending_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Pool owned by the library, used to run asynchronous event listeners.
+     */
+    static ThreadPool& shared();
+
+  private:
+    struct Worker {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+      std::thread thread;
+    };
+
+    void run(std::size_t index);
+    [[nodiscard]] bool pop(std::size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::size_t capacity_;
+
+    std::atomic<std::size_t> pending_{0};   // Reserved by submit(), bounded by capacity_
+    std::atomic<std::size_t> queued_{0};    // Pushed to a deque, wakes the workers up
+    std::atomic<std::size_t> blocked_{0};   // Producers waiting for room
+    std::atomic<std::size_t> sleeping_{0};  // Workers waiting for tasks
+    std::atomic<std::size_t> next_{0};
+
+    // Serializes sleeping with waking up, for both workers and blocked producers
+    std::mutex mutex_;
+    std::condition_variable workAvailable_;
+    std::condition_variable spaceAvailable_;
+    bool stopping_ = false;
+  };
+
+}  // namespace deskgui
@@ -8,10 +8,13 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace deskgui {
   // Defines the size of a view, represented by width and height.
@@ -33,6 +36,11 @@ namespace deskgui {
     kPhysical  // Physical pixels.
   };
 
+  enum class ReadMode {
+    kCached,  // Last known value, returned immediately from any thread.
+    kFresh    // Value read from the native window on the main thread.
+  };
+
   // Represents the default rectangle for a window.
   static const ViewRect kDefaultWindowRect = {0, 0, 600, 600};
 
@@ -42,6 +50,24 @@ namespace deskgui {
   // Function type for bind callbacks that return string values.
   using BindCallback = std::function<std::string(const std::string&)>;
 
+  // Callback function type receiving the result of a script, serialized to JSON.
+  using ScriptCallback = std::function<void(const std::string&)>;
+
+  // Callback function type run when a timer expires.
+  using TimerCallback = std::function<void()>;
+
+  // File descriptor watched by the main loop, with the poll(2) events it waits for.
+  struct PollDescriptor {
+    int fd;
+    short events;
+  };
+
+  // What an external event loop waits for before stepping the main loop.
+  struct PollInfo {
+    std::vector<PollDescriptor> descriptors;
+    std::optional<std::chrono::milliseconds> timeout;  // Empty if only the descriptors matter.
+  };
+
   using UniqueId = size_t;
 
   struct UniqueIdGenerator {
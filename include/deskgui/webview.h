@@ -8,14 +8,29 @@
 #pragma once
 
 #include <deskgui/app_handler.h>
+#include <deskgui/awaitable.h>
 #include <deskgui/event_bus.h>
+#include <deskgui/inplace_function.h>
+#include <deskgui/json_traits.h>
 #include <deskgui/resource_compiler.h>
 #include <deskgui/types.h>
 #include <deskgui/webview_options.h>
 
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
 namespace deskgui {
   class Window;
 
+  // Callback function type receiving the parsed payload of a message.
+  using JsonCallback = std::function<void(const rapidjson::Value&)>;
+
+  // Function type for typed bound functions, reading the arguments array and writing the result.
+  using JsonBindCallback = std::function<void(const rapidjson::Value& args, JsonWriter& result)>;
+
   /**
    * @class Webview
    * @brief The Webview class represents a web view widget.
@@ -157,6 +172,20 @@ namespace deskgui {
      */
     [[nodiscard]] std::string getUrl();
 
+    /**
+     * @brief Gets the current URL of the web view from a C++20 coroutine.
+     *
+     * The coroutine does not hold its thread while waiting and resumes on the main thread.
+     *
+     * Example:
+     * @code{.cpp}
+     * std::string url = co_await webview->getUrlAsync();
+     * @endcode
+     *
+     * @return An awaiter producing the current URL.
+     */
+    [[nodiscard]] ResultAwaiter<std::string> getUrlAsync();
+
     // Functionality
 
     /**
@@ -173,6 +202,30 @@ namespace deskgui {
      */
     void executeScript(const std::string& script);
 
+    /**
+     * @brief Executes a script in the web view and retrieves its result.
+     *
+     * @param script The script to execute.
+     * @param callback Called on the main thread with the result of the script serialized to JSON,
+     *                 or with an empty string if the script failed.
+     */
+    void evaluateScript(const std::string& script, ScriptCallback callback);
+
+    /**
+     * @brief Executes a script in the web view and retrieves its result from a C++20 coroutine.
+     *
+     * The coroutine does not hold its thread while waiting and resumes on the main thread.
+     *
+     * Example:
+     * @code{.cpp}
+     * std::string title = co_await webview->evaluateScriptAsync("document.title");
+     * @endcode
+     *
+     * @param script The script to execute.
+     * @return An awaiter producing the result of the script, as for evaluateScript.
+     */
+    [[nodiscard]] ResultAwaiter<std::string> evaluateScriptAsync(const std::string& script);
+
     /**
      * @brief Adds a callback function with the specified name.
      *
@@ -184,6 +237,18 @@ namespace deskgui {
      */
     void addCallback(const std::string& key, MessageCallback callback);
 
+    /**
+     * @brief Adds a callback function receiving the payload already parsed.
+     *
+     * The message is parsed once, in place, and the callback reads the payload straight from the
+     * parsed document instead of parsing its JSON text again. The value is only valid during the
+     * call.
+     *
+     * @param key The name (key) of the callback.
+     * @param callback The callback function to be invoked when the JavaScript function is called.
+     */
+    void addCallback(const std::string& key, JsonCallback callback);
+
     /**
      * @brief Removes the callback function for the specified key.
      *
@@ -202,6 +267,50 @@ namespace deskgui {
      */
     void bind(const std::string& key, BindCallback func);
 
+    /**
+     * @brief Binds a C++ function that can return values to JavaScript, run off the main thread.
+     *
+     * Works like bind(), but each call runs on the application's background thread pool, so a
+     * slow function does not freeze the windows. Calls may run concurrently, with each other and
+     * with the main thread, and their results are delivered back to JavaScript in the order they
+     * complete. Calls made while the pool queue is full are rejected. Webviews created without an
+     * application run the function synchronously.
+     *
+     * @param key The name (key) of the function.
+     * @param func The function to be bound that returns a string value, called from worker threads.
+     */
+    void bindAsync(const std::string& key, BindCallback func);
+
+    /**
+     * @brief Binds a typed C++ function to JavaScript.
+     *
+     * The JavaScript function takes the arguments one by one and returns a Promise. They are read
+     * from the parsed message into the C++ parameter types, and the result is written as JSON,
+     * through JsonTraits, so the function never handles JSON text. The call is rejected if the
+     * arguments do not match the signature.
+     *
+     * Example:
+     * @code{.cpp}
+     * webview->bind<double(const std::vector<double>&)>("sum", [](const auto& values) {
+     *   return std::accumulate(values.begin(), values.end(), 0.0);
+     * });
+     * @endcode
+     * @code{.js}
+     * const total = await window.sum([1, 2, 3]);
+     * @endcode
+     *
+     * @tparam Signature The function type, whose parameter and result types have JsonTraits.
+     * @param key The name (key) of the function.
+     * @param func The function to be bound, callable with the parameters of Signature.
+     */
+    template <typename Signature, typename Function>
+    void bind(const std::string& key, Function func) {
+      bindJson(key, [func = std::move(func)](const rapidjson::Value& args,
+                                             JsonWriter& result) mutable {
+        JsonFunction<Signature>::call(func, args, result);
+      });
+    }
+
     /**
      * @brief Unbinds a previously bound C++ function.
      *
@@ -214,8 +323,8 @@ namespace deskgui {
     /**
      * @brief Processes pending responses from bind function calls.
      *
-     * This method should be called regularly to process any pending responses
-     * from bind function calls and send them back to JavaScript.
+     * Responses are sent automatically, in a single script per main loop iteration. This method
+     * sends the ones queued so far right away.
      */
     void processPendingResponses();
 
@@ -233,6 +342,44 @@ namespace deskgui {
      */
     void resize(const ViewSize& size);
 
+    /**
+     * @brief Runs a group of webview operations in a single main thread hop.
+     *
+     * The operations receive this webview on the main thread, where its methods run directly.
+     * Position and size changes within the batch are coalesced: only the last of each is applied,
+     * once, when the batch ends. Batches returning void are posted without waiting for them, while
+     * batches returning a value block until it is available.
+     *
+     * Example:
+     * @code{.cpp}
+     * webview->batch([](Webview& webview) {
+     *   webview.setPosition({0, 0, 800, 600});
+     *   webview.resize({800, 600});
+     *   webview.show(true);
+     * });
+     * @endcode
+     *
+     * @tparam Operations The type of the callable object, invoked with a Webview reference
+     * @param operations The callable object running the operations
+     * @return The result of the operations, if applicable.
+     * @throws std::runtime_error If a batch returning a value was abandoned without running, because
+     * the application was destroyed or the webview closed before the main thread reached it.
+     */
+    template <typename Operations> auto batch(Operations&& operations) {
+      using ResultType = std::invoke_result_t<Operations&, Webview&>;
+
+      if constexpr (std::is_void_v<ResultType>) {
+        postBatch(std::forward<Operations>(operations));
+      } else {
+        std::optional<ResultType> result;
+        runBatch([&operations, &result](Webview& webview) { result.emplace(operations(webview)); });
+        if (!result) {
+          throw std::runtime_error("The batch was abandoned before it ran");
+        }
+        return std::move(*result);
+      }
+    }
+
     /**
      * @brief Connects a listener to a webview event type.
      *
@@ -249,11 +396,56 @@ namespace deskgui {
      * @tparam EventType The type of webview event to listen for
      * @tparam Callable The type of the callable object (lambda, function, etc.)
      * @param listener The callable object to be called when the event is emitted
+     * @param priority Listeners with a higher priority are called first. Listeners with the same
+     * priority are called in connect order.
+     * @return A unique ID that can be used to disconnect the listener later
+     */
+    template <class EventType, typename Callable>
+    [[maybe_unused]] UniqueId connect(Callable&& listener, int priority = 0) {
+      return events_->connect<EventType>(std::forward<Callable>(listener), priority);
+    }
+
+    /**
+     * @brief Connects a listener that runs on a library-owned thread pool.
+     *
+     * The listener receives a copy of each event and does not hold up the thread emitting it, so
+     * it suits slow work such as logging. It may run concurrently with itself and can't cancel
+     * the event. Events emitted while the pool queue is full are dropped for the listener, and
+     * its exceptions are discarded. Non-owning view events can't be listened to asynchronously.
+     *
+     * @tparam EventType The type of webview event to listen for
+     * @tparam Callable The type of the callable object (lambda, function, etc.)
+     * @param listener The callable object to be called with a const reference to the event copy
+     * @return A unique ID that can be used to disconnect the listener later
+     */
+    template <class EventType, typename Callable>
+    [[maybe_unused]] UniqueId connectAsync(Callable&& listener) {
+      return events_->connectAsync<EventType>(std::forward<Callable>(listener));
+    }
+
+    /**
+     * @brief Connects a listener to the webview events emitted with a given key.
+     *
+     * WebviewOnMessage and WebviewOnMessageView are emitted with the "key" field of the message,
+     * so the listener is only invoked for the messages it is interested in.
+     *
+     * Example:
+     * @code{.cpp}
+     * webview->connect<WebviewOnMessage>("ping", [](const WebviewOnMessage& event) {
+     *   // Handle {"key": "ping", ...} messages
+     * });
+     * @endcode
+     *
+     * @tparam EventType The type of webview event to listen for
+     * @tparam Callable The type of the callable object (lambda, function, etc.)
+     * @param key The key the events must be emitted with
+     * @param listener The callable object to be called when the event is emitted
+     * @param priority Listeners with a higher priority are called first.
      * @return A unique ID that can be used to disconnect the listener later
      */
     template <class EventType, typename Callable>
-    [[maybe_unused]] UniqueId connect(Callable&& listener) {
-      return events_->connect<EventType>(std::forward<Callable>(listener));
+    [[maybe_unused]] UniqueId connect(std::string_view key, Callable&& listener, int priority = 0) {
+      return events_->connect<EventType>(key, std::forward<Callable>(listener), priority);
     }
 
     /**
@@ -267,6 +459,14 @@ namespace deskgui {
     }
 
   private:
+    using BatchOperations = InplaceFunction<void(Webview&)>;
+
+    void bindJson(const std::string& key, JsonBindCallback func);
+
+    void runBatch(const BatchOperations& operations);
+    void postBatch(BatchOperations&& operations);
+    void applyBatch(const BatchOperations& operations);
+
     std::shared_ptr<Impl> impl_{nullptr};
 
     EventBus* events_;
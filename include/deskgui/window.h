@@ -9,9 +9,16 @@
 
 #include <deskgui/app_handler.h>
 #include <deskgui/event_bus.h>
+#include <deskgui/inplace_function.h>
 #include <deskgui/types.h>
 #include <deskgui/webview.h>
 
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
 namespace deskgui {
   class App;
   /**
@@ -95,9 +102,11 @@ namespace deskgui {
     /**
      * @brief Gets the title of the window.
      *
+     * @param mode Whether to return the last known title without waiting for the main thread,
+     *             which is the default, or to read it from the native window.
      * @return The window title.
      */
-    [[nodiscard]] std::string getTitle() const;
+    [[nodiscard]] std::string getTitle(ReadMode mode = ReadMode::kCached) const;
 
     /**
      * @brief Sets the size of the window.
@@ -113,9 +122,12 @@ namespace deskgui {
      *
      * @param type The type of pixels used for the size. Default is logical pixels.
      *             It can be either logical or physical.
+     * @param mode Whether to read the native window on the main thread, which is the default, or
+     *             to return the size last reported by a native resize without waiting.
      * @return The window size.
      */
-    [[nodiscard]] ViewSize getSize(PixelsType type = PixelsType::kLogical) const;
+    [[nodiscard]] ViewSize getSize(PixelsType type = PixelsType::kLogical,
+                                   ReadMode mode = ReadMode::kFresh) const;
 
     /**
      * @brief Sets the maximum size of the window.
@@ -179,9 +191,13 @@ namespace deskgui {
      *
      * @param type The type of pixels used for the position. Default is logical pixels.
      *             It can be either logical or physical.
+     * @param mode Whether to read the native window on the main thread, which is the default, or
+     *             to return the position last reported by a native move or resize without
+     *             waiting.
      * @return The position of the window.
      */
-    [[nodiscard]] ViewRect getPosition(PixelsType type = PixelsType::kLogical) const;
+    [[nodiscard]] ViewRect getPosition(PixelsType type = PixelsType::kLogical,
+                                       ReadMode mode = ReadMode::kFresh) const;
 
     /**
      * @brief Sets whether the window is resizable.
@@ -193,9 +209,11 @@ namespace deskgui {
     /**
      * @brief Checks if the window is resizable.
      *
+     * @param mode Whether to return the last known state without waiting for the main thread,
+     *             which is the default, or to read it from the native window.
      * @return True if the window is resizable, false otherwise.
      */
-    [[nodiscard]] bool isResizable() const;
+    [[nodiscard]] bool isResizable(ReadMode mode = ReadMode::kCached) const;
 
     /**
      * @brief Sets whether the window has decorations such as borders and title bar.
@@ -210,10 +228,12 @@ namespace deskgui {
     /**
      * @brief Checks if the window has decorations such as borders and title bar.
      *
+     * @param mode Whether to return the last known state without waiting for the main thread,
+     *             which is the default, or to read it from the native window.
      * @return True if the window has decorations (borders, title bar, etc.), false if it is
      *         borderless and more minimalistic without decorations.
      */
-    [[nodiscard]] bool isDecorated() const;
+    [[nodiscard]] bool isDecorated(ReadMode mode = ReadMode::kCached) const;
 
     /**
      * @brief Hides the window.
@@ -295,9 +315,53 @@ namespace deskgui {
      * Retrieves the scaling factor representing the DPI (dots per inch) scale
      * or display pixel density for the current screen or display.
      *
+     * @param mode Whether to return the last known factor without waiting for the main thread,
+     *             which is the default, or to read it on the main thread.
      * @return The display scale factor.
      */
-    float getMonitorScaleFactor() const;
+    float getMonitorScaleFactor(ReadMode mode = ReadMode::kCached) const;
+
+    /**
+     * @brief Runs a group of window operations in a single main thread hop.
+     *
+     * The operations receive this window on the main thread, where its methods run directly.
+     * Geometry set within the batch (size, minimum and maximum size, position and centering) is
+     * coalesced: only the last value of each is applied, once, when the batch ends. Getters called
+     * within the batch still see the geometry from before it.
+     *
+     * Like the setters, batches returning void are posted without waiting for them, while batches
+     * returning a value block until it is available.
+     *
+     * Example:
+     * @code{.cpp}
+     * window->batch([](Window& window) {
+     *   window.setTitle("deskgui");
+     *   window.setSize({800, 600});
+     *   window.center();
+     *   window.show();
+     * });
+     * @endcode
+     *
+     * @tparam Operations The type of the callable object, invoked with a Window reference
+     * @param operations The callable object running the operations
+     * @return The result of the operations, if applicable.
+     * @throws std::runtime_error If a batch returning a value was abandoned without running, because
+     * the application was destroyed or the window closed before the main thread reached it.
+     */
+    template <typename Operations> auto batch(Operations&& operations) {
+      using ResultType = std::invoke_result_t<Operations&, Window&>;
+
+      if constexpr (std::is_void_v<ResultType>) {
+        postBatch(std::forward<Operations>(operations));
+      } else {
+        std::optional<ResultType> result;
+        runBatch([&operations, &result](Window& window) { result.emplace(operations(window)); });
+        if (!result) {
+          throw std::runtime_error("The batch was abandoned before it ran");
+        }
+        return std::move(*result);
+      }
+    }
 
     /**
      * @brief Connects a listener to a window event type.
@@ -313,11 +377,31 @@ namespace deskgui {
      * @tparam EventType The type of window event to listen for
      * @tparam Callable The type of the callable object (lambda, function, etc.)
      * @param listener The callable object to be called when the event is emitted
+     * @param priority Listeners with a higher priority are called first. Listeners with the same
+     * priority are called in connect order.
      * @return A unique ID that can be used to disconnect the listener later
      */
     template <class EventType, typename Callable>
-    [[maybe_unused]] UniqueId connect(Callable&& listener) {
-      return events_->connect<EventType>(std::forward<Callable>(listener));
+    [[maybe_unused]] UniqueId connect(Callable&& listener, int priority = 0) {
+      return events_->connect<EventType>(std::forward<Callable>(listener), priority);
+    }
+
+    /**
+     * @brief Connects a listener that runs on a library-owned thread pool.
+     *
+     * The listener receives a copy of each event and does not hold up the thread emitting it, so
+     * it suits slow work such as logging. It may run concurrently with itself and can't cancel
+     * the event. Events emitted while the pool queue is full are dropped for the listener, and
+     * its exceptions are discarded. Non-owning view events can't be listened to asynchronously.
+     *
+     * @tparam EventType The type of window event to listen for
+     * @tparam Callable The type of the callable object (lambda, function, etc.)
+     * @param listener The callable object to be called with a const reference to the event copy
+     * @return A unique ID that can be used to disconnect the listener later
+     */
+    template <class EventType, typename Callable>
+    [[maybe_unused]] UniqueId connectAsync(Callable&& listener) {
+      return events_->connectAsync<EventType>(std::forward<Callable>(listener));
     }
 
     /**
@@ -334,6 +418,12 @@ namespace deskgui {
     }
 
   private:
+    using BatchOperations = InplaceFunction<void(Window&)>;
+
+    void runBatch(const BatchOperations& operations);
+    void postBatch(BatchOperations&& operations);
+    void applyBatch(const BatchOperations& operations);
+
     std::shared_ptr<Impl> impl_{nullptr};
 
     EventBus* events_;
@@ -7,11 +7,18 @@
 
 #include "interfaces/app_impl.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 using namespace deskgui;
 
-App::App(const std::string& name) : impl_(std::make_unique<Impl>(name)) {}
+App::App(const std::string& name, std::size_t backgroundThreads)
+    : impl_(std::make_unique<Impl>(name, backgroundThreads)) {}
 
-App::~App() = default;
+App::~App() {
+  // Queued work may still post continuations, so the pool is joined while the app is whole
+  impl_->stopBackground();
+}
 
 Window* App::Impl::createWindow(const std::string& name, AppHandler* appHandler,
                                 void* nativeWindow) {
@@ -73,6 +80,21 @@ bool App::isRunning() const { return impl_->isRunning(); }
 
 void App::run() { impl_->run(); }
 
+bool App::Impl::enterExternalLoop() {
+  if (!externalLoop_) {
+    externalLoop_ = true;
+    mainThreadId_.store(std::this_thread::get_id(), std::memory_order_release);
+    isRunning_.store(true);
+  }
+  return isRunning_.load();
+}
+
+bool App::poll(std::chrono::milliseconds timeout) { return impl_->poll(timeout); }
+
+bool App::step() { return impl_->poll(std::chrono::milliseconds::zero()); }
+
+PollInfo App::getPollInfo() { return impl_->getPollInfo(); }
+
 void App::terminate() {
   if (!isMainThread()) {
     return dispatchOnMainThread([this]() { terminate(); });
@@ -82,4 +104,134 @@ void App::terminate() {
 
 bool App::isMainThread() const { return impl_->isMainThread(); }
 
-void App::dispatch(DispatchTask&& task) const { impl_->dispatch(std::move(task)); }
\ No newline at end of file
+void App::Impl::attachEvents(EventBus& events) {
+  eventBuses_.push_back(&events);
+
+  // A single drain is scheduled per burst: the bus only wakes up when its queue stops being empty.
+  // Events are mostly input, so they are delivered ahead of the other queued tasks.
+  events.setWakeup([this] { dispatch([this] { drainEvents(); }, DispatchPriority::kImmediate); });
+  if (events.hasPosted()) {
+    dispatch([this] { drainEvents(); }, DispatchPriority::kImmediate);
+  }
+}
+
+void App::attachEvents(EventBus& events) { impl_->attachEvents(events); }
+
+void App::Impl::detachEvents(EventBus& events) {
+  events.setWakeup(nullptr);
+  std::replace(eventBuses_.begin(), eventBuses_.end(), &events, static_cast<EventBus*>(nullptr));
+}
+
+void App::detachEvents(EventBus& events) { impl_->detachEvents(events); }
+
+void App::Impl::drainEvents() {
+  // Listeners may attach or detach buses, so eventBuses_ is indexed on every iteration
+  for (std::size_t index = 0; index < eventBuses_.size(); ++index) {
+    if (auto* events = eventBuses_[index]) {
+      events->drain();
+    }
+  }
+  eventBuses_.erase(std::remove(eventBuses_.begin(), eventBuses_.end(), nullptr),
+                    eventBuses_.end());
+}
+
+ThreadPool& App::Impl::backgroundPool() {
+  std::call_once(backgroundPoolStarted_, [this] {
+    backgroundPool_ = std::make_unique<ThreadPool>(
+        backgroundThreads_ > 0 ? backgroundThreads_ : std::thread::hardware_concurrency());
+  });
+  return *backgroundPool_;
+}
+
+void App::Impl::stopBackground() { backgroundPool_.reset(); }
+
+ThreadPool& App::backgroundPool() const { return impl_->backgroundPool(); }
+
+UniqueId App::Impl::addTimer(TimerCallback callback, std::chrono::milliseconds delay,
+                            std::chrono::milliseconds interval) {
+  const auto id = UniqueIdGenerator::newId();
+  {
+    std::lock_guard lock(timersMutex_);
+    timers_.add(id, TimerWheel::Clock::now() + delay, interval, std::move(callback));
+  }
+
+  // The native timer belongs to the main thread; a single arming task is queued per burst
+  if (isMainThread()) {
+    armTimers();
+  } else if (!armPending_.exchange(true)) {
+    dispatch([this] { armTimers(); }, DispatchPriority::kImmediate);
+  }
+  return id;
+}
+
+void App::Impl::cancelTimer(UniqueId id) {
+  // The native timer stays armed, a wake-up with nothing to run is cheaper than re-arming
+  std::lock_guard lock(timersMutex_);
+  timers_.cancel(id);
+}
+
+void App::Impl::runTimers() {
+  // Native timers are one-shot
+  armedWake_ = TimerWheel::Clock::time_point::max();
+
+  expiredTimers_.clear();
+  {
+    std::lock_guard lock(timersMutex_);
+    timers_.advance(TimerWheel::Clock::now(), expiredTimers_);
+  }
+
+  // Fired one at a time, so a callback can cancel a timer expiring at the same time
+  for (const auto id : expiredTimers_) {
+    TimerWheel::Callback callback;
+    {
+      std::lock_guard lock(timersMutex_);
+      callback = timers_.fire(id);
+    }
+    if (callback) {
+      (*callback)();
+    }
+  }
+
+  armTimers();
+}
+
+void App::Impl::armTimers() {
+  armPending_ = false;
+
+  std::optional<TimerWheel::Clock::time_point> next;
+  {
+    std::lock_guard lock(timersMutex_);
+    next = timers_.nextExpiry();
+  }
+  if (!next) {
+    return;
+  }
+
+  const auto wake = TimerWheel::Clock::time_point(
+      std::chrono::ceil<TimerTolerance>(next->time_since_epoch()));
+  if (wake >= armedWake_) {
+    return;
+  }
+  armedWake_ = wake;
+  armTimer(std::max(wake - TimerWheel::Clock::now(), TimerWheel::Clock::duration{}));
+}
+
+UniqueId App::setTimeout(TimerCallback callback, std::chrono::milliseconds delay) {
+  return impl_->addTimer(std::move(callback), delay, std::chrono::milliseconds::zero());
+}
+
+UniqueId App::setInterval(TimerCallback callback, std::chrono::milliseconds interval) {
+  // The timer wheel takes a zero interval for a one-shot timer
+  if (interval <= std::chrono::milliseconds::zero()) {
+    throw std::invalid_argument("App::setInterval: the interval must be positive");
+  }
+  return impl_->addTimer(std::move(callback), interval, interval);
+}
+
+void App::cancel(UniqueId id) { impl_->cancelTimer(id); }
+
+void App::dispatch(DispatchTask&& task, DispatchPriority priority) const {
+  impl_->dispatch(std::move(task), priority);
+}
+
+void App::dispatch(DispatchRequest& request) const { impl_->dispatch(request); }
\ No newline at end of file
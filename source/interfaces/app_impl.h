@@ -10,16 +10,21 @@
 #include <deskgui/app.h>
 
 #include <atomic>
+#include <chrono>
 #include <future>
+#include <mutex>
 #include <set>
 #include <thread>
+#include <vector>
+
+#include "utils/timer_wheel.h"
 
 namespace deskgui {
   class App::Impl {
   public:
     class Platform;
 
-    explicit Impl(const std::string& name);
+    Impl(const std::string& name, std::size_t backgroundThreads);
     ~Impl();
 
     [[nodiscard]] Window* createWindow(const std::string& name, AppHandler* appHandler,
@@ -31,20 +36,70 @@ namespace deskgui {
 
     void run();
     void terminate();
+
+    // External event loop integration, making the calling thread the main thread
+    bool poll(std::chrono::milliseconds timeout);
+    [[nodiscard]] PollInfo getPollInfo();
     [[nodiscard]] inline bool isRunning() const { return isRunning_.load(); }
 
     [[nodiscard]] inline bool isMainThread() const {
-      return std::this_thread::get_id() == mainThreadId_;
+      return std::this_thread::get_id() == mainThreadId_.load(std::memory_order_acquire);
     }
-    void dispatch(DispatchTask&& task);
+    void dispatch(DispatchTask&& task, DispatchPriority priority);
+    void dispatch(DispatchRequest& request);
+
+    void attachEvents(EventBus& events);
+    void detachEvents(EventBus& events);
+    void drainEvents();
+
+    // Started on first use
+    [[nodiscard]] ThreadPool& backgroundPool();
+    // Runs the work still queued and joins the workers
+    void stopBackground();
+
+    [[nodiscard]] UniqueId addTimer(TimerCallback callback, std::chrono::milliseconds delay,
+                                    std::chrono::milliseconds interval);
+    void cancelTimer(UniqueId id);
+
+    // Called by the platform when its native timer fires, on the main thread
+    void runTimers();
 
   private:
+    // Makes the calling thread the main thread on first use; false once terminated
+    bool enterExternalLoop();
+
+    // Main thread only: arms the native timer for the next timer wheel expiry
+    void armTimers();
+    void armTimer(TimerWheel::Clock::duration delay);
+
     std::unique_ptr<Platform> platform_{nullptr};
 
     std::string name_;
     std::atomic<bool> isRunning_{false};
-    std::thread::id mainThreadId_;
+    // Set by run() or the first poll(), while other threads read it to decide whether to dispatch
+    std::atomic<std::thread::id> mainThreadId_;
+    bool externalLoop_ = false;  // Driven through poll() instead of run()
+
+    // Buses drained by drainEvents(), only accessed from the main thread. Detached buses are
+    // nulled out and erased by the next drain, so a listener may destroy a window while draining.
+    // Declared before windows_, which detach their buses when destroyed.
+    std::vector<EventBus*> eventBuses_;
 
     std::unordered_map<std::string, std::unique_ptr<Window>> windows_;
+
+    // Wake-ups are aligned on this window, so that timers expiring within it fire together
+    using TimerTolerance = std::chrono::duration<std::int64_t, std::ratio<4, 1000>>;
+
+    std::mutex timersMutex_;
+    TimerWheel timers_;
+    std::atomic<bool> armPending_{false};
+
+    // Main thread only
+    TimerWheel::Clock::time_point armedWake_ = TimerWheel::Clock::time_point::max();
+    std::vector<UniqueId> expiredTimers_;
+
+    std::size_t backgroundThreads_;
+    std::once_flag backgroundPoolStarted_;
+    std::unique_ptr<ThreadPool> backgroundPool_;
   };
 }  // namespace deskgui
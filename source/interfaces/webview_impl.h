@@ -10,12 +10,19 @@
 #include <deskgui/event_bus.h>
 #include <deskgui/webview.h>
 
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "utils/message_parser.h"
+
 namespace deskgui {
 
-  class Webview::Impl {
+  // Shared with the asynchronous bound functions, which only deliver their result if it is alive
+  class Webview::Impl : public std::enable_shared_from_this<Webview::Impl> {
   public:
     class Platform;
 
@@ -44,6 +51,14 @@ namespace deskgui {
     void show(bool state);
     void resize(const ViewSize& size);
 
+    // Position and size changes, deferred to the end of the current batch if any
+    void requestPosition(const ViewRect& rect);
+    void requestResize(const ViewSize& size);
+
+    // Batches may nest, the geometry is applied when the outermost one ends
+    inline void beginBatch() { ++batchDepth_; }
+    void endBatch();
+
     // Content
     void navigate(const std::string& url);
     void loadFile(const std::string& path);
@@ -55,28 +70,69 @@ namespace deskgui {
 
     // Functionality
     void addCallback(const std::string& key, MessageCallback callback);
+    void addJsonCallback(const std::string& key, JsonCallback callback);
     void removeCallback(const std::string& key);
     void bind(const std::string& key, BindCallback func);
+    void bindAsync(const std::string& key, BindCallback func);
+    void bindJson(const std::string& key, JsonBindCallback func);
     void unbind(const std::string& key);
     void processPendingResponses();
     void postMessage(const std::string& message);
     void injectScript(const std::string& script);
     void executeScript(const std::string& script);
-    void onMessage(const std::string& message);
+    void evaluateScript(const std::string& script, ScriptCallback callback);
+    inline void resolveUrl(const ResultAwaiter<std::string>::Callback& callback) {
+      callback(getUrl());
+    }
+    void onMessage(std::string_view message);
+
+    // Emit the owning and non-owning variants of navigation events from the platform layer
+    [[nodiscard]] bool onNavigationStarting(std::string_view url);
+    void onSourceChanged(std::string_view source);
 
     [[nodiscard]] inline AppHandler* application() const { return appHandler_; }
     [[nodiscard]] inline EventBus& events() { return events_; }
 
-    [[nodiscard]] inline std::vector<std::string>& getPendingResponses() { return pending_responses_; }
-
   private:
+    struct BoundFunction {
+      std::shared_ptr<const BindCallback> callback;  // Shared with the calls still running
+      bool async = false;
+      std::shared_ptr<const JsonBindCallback> typed{};  // Set instead of callback when typed
+    };
+
+    void handleMessage(MessageParser& parser, std::string_view message);
+    void callBound(const BoundFunction& function, std::uint64_t requestId,
+                   const rapidjson::Value* payload, std::string_view rawPayload);
+
+    // Queue the settlement of a bound function call and send it to JavaScript
+    void resolveBound(std::uint64_t requestId, std::string_view result);
+    void rejectBound(std::uint64_t requestId, const std::string& error);
+
+    // Sends the queued settlements in one script, once the main loop is done with the current
+    // batch of messages and tasks
+    void scheduleResponses();
+
+    // Message callbacks get the payload both as the JSON text of the message and parsed
+    using PayloadHandler
+        = std::function<void(std::string_view json, const rapidjson::Value& value)>;
+
     std::unique_ptr<Platform> platform_{nullptr};
     std::string name_;
-    std::unordered_map<std::string, MessageCallback> callbacks_;
-    std::unordered_map<std::string, BindCallback> bind_functions_;
+    std::unordered_map<std::string, PayloadHandler> callbacks_;
+    std::unordered_map<std::string, BoundFunction> bind_functions_;
     std::vector<std::string> pending_responses_;
+    bool responsesScheduled_{false};
+
+    // Reused for every message; nested messages, delivered while a handler runs, get their own
+    MessageParser parser_;
+    int messageDepth_{0};
     AppHandler* appHandler_{nullptr};
     Resources resources_;
+
+    // Last geometry requested within the current batch
+    int batchDepth_{0};
+    std::optional<ViewRect> pendingPosition_;
+    std::optional<ViewSize> pendingSize_;
     EventBus events_;
   };
 
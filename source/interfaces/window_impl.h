@@ -13,6 +13,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 
@@ -71,14 +72,63 @@ namespace deskgui {
     [[nodiscard]] void* getNativeWindow();
     [[nodiscard]] void* getContentView();
 
-    inline void setMonitorScaleFactor(float scaleFactor) { monitorScaleFactor_ = scaleFactor; }
+    inline void setMonitorScaleFactor(float scaleFactor) {
+      monitorScaleFactor_ = scaleFactor;
+      cacheScaleFactor(scaleFactor);
+    }
     [[nodiscard]] inline float getMonitorScaleFactor() const { return monitorScaleFactor_; }
 
+    // Setters that also update the cached state, once applied on the main thread
+    void applyTitle(const std::string& title);
+    void applyResizable(bool resizable);
+    void applyDecorations(bool decorations);
+
+    // Last known state, readable from any thread. Updated by the setters as soon as they are
+    // called, and refreshed from the native window by refreshState on the main thread.
+    void refreshState();
+    void cacheTitle(const std::string& title);
+    [[nodiscard]] std::string cachedTitle() const;
+    inline void cacheResizable(bool resizable) {
+      cachedResizable_.store(resizable, std::memory_order_relaxed);
+    }
+    [[nodiscard]] inline bool cachedResizable() const {
+      return cachedResizable_.load(std::memory_order_relaxed);
+    }
+    inline void cacheDecorations(bool decorations) {
+      cachedDecorated_.store(decorations, std::memory_order_relaxed);
+    }
+    [[nodiscard]] inline bool cachedDecorated() const {
+      return cachedDecorated_.load(std::memory_order_relaxed);
+    }
+    inline void cacheScaleFactor(float scaleFactor) {
+      cachedScaleFactor_.store(scaleFactor, std::memory_order_relaxed);
+    }
+    [[nodiscard]] inline float cachedScaleFactor() const {
+      return cachedScaleFactor_.load(std::memory_order_relaxed);
+    }
+
+    // Size and position, in physical pixels, refreshed by the platform when the native window is
+    // resized or moved
+    void refreshGeometry();
+    void cacheGeometry(const ViewSize& size, const ViewRect& position);
+    [[nodiscard]] ViewSize cachedSize(PixelsType type) const;
+    [[nodiscard]] ViewRect cachedPosition(PixelsType type) const;
+
+    // Geometry changes, deferred to the end of the current batch if any
+    void requestSize(const ViewSize& size, PixelsType type);
+    void requestMaxSize(const ViewSize& size, PixelsType type);
+    void requestMinSize(const ViewSize& size, PixelsType type);
+    void requestPosition(const ViewRect& position, PixelsType type);
+    void requestCenter();
+
+    // Batches may nest, the geometry is applied when the outermost one ends
+    inline void beginBatch() { ++batchDepth_; }
+    void endBatch();
+
     [[nodiscard]] inline AppHandler* application() const { return appHandler_; }
     [[nodiscard]] inline EventBus& events() { return events_; }
     [[nodiscard]] inline Platform* platform() { return platform_.get(); }
 
-
   private:
     std::unique_ptr<Platform> platform_{nullptr};
 
@@ -98,6 +148,27 @@ namespace deskgui {
 
     float monitorScaleFactor_ = 1.f;
 
+    mutable std::mutex cachedTitleMutex_;
+    std::string cachedTitle_;
+    std::atomic<bool> cachedResizable_{false};
+    std::atomic<bool> cachedDecorated_{false};
+    std::atomic<float> cachedScaleFactor_{1.f};
+    mutable std::mutex cachedGeometryMutex_;
+    ViewSize cachedSize_;
+    ViewRect cachedPosition_;
+
+    // Last geometry requested within the current batch
+    struct PendingGeometry {
+      std::optional<std::pair<ViewSize, PixelsType>> size;
+      std::optional<std::pair<ViewSize, PixelsType>> maxSize;
+      std::optional<std::pair<ViewSize, PixelsType>> minSize;
+      std::optional<std::pair<ViewRect, PixelsType>> position;
+      bool center{false};
+    };
+
+    int batchDepth_{0};
+    PendingGeometry pendingGeometry_;
+
     EventBus events_;
   };
 
@@ -14,8 +14,11 @@ using namespace deskgui;
 
 using Impl = App::Impl;
 
-Impl::Impl(const std::string& name) : platform_(std::make_unique<Impl::Platform>()), name_(name) {
-  mainThreadId_ = std::this_thread::get_id();
+Impl::Impl(const std::string& name, std::size_t backgroundThreads)
+    : platform_(std::make_unique<Impl::Platform>(*this)),
+      name_(name),
+      backgroundThreads_(backgroundThreads) {
+  mainThreadId_.store(std::this_thread::get_id(), std::memory_order_release);
 }
 
 Impl::~Impl() {
@@ -30,7 +33,7 @@ void Impl::run() {
   }
 
   isRunning_.store(true);
-  mainThreadId_ = std::this_thread::get_id();
+  mainThreadId_.store(std::this_thread::get_id(), std::memory_order_release);
 
   @autoreleasepool {
     [NSApplication sharedApplication];
@@ -41,13 +44,88 @@ void Impl::run() {
 void Impl::terminate() {
   if (isRunning_.load()) {
     isRunning_.store(false);
-    [NSApp terminate:nil];
+    // Terminating exits the process, an external loop stops polling on its own instead
+    if ([NSApp isRunning]) {
+      [NSApp terminate:nil];
+    }
   }
 }
 
-void Impl::dispatch(DispatchTask&& task) {
+bool Impl::poll(std::chrono::milliseconds timeout) {
+  if (!enterExternalLoop()) {
+    return false;
+  }
+
+  @autoreleasepool {
+    static std::once_flag launched;
+    std::call_once(launched, [] {
+      [NSApplication sharedApplication];
+      [NSApp finishLaunching];
+    });
+
+    // Running the run loop for the next event also drains the main dispatch queue
+    const auto seconds = std::chrono::duration<double>(timeout).count();
+    NSDate* until = [NSDate dateWithTimeIntervalSinceNow:seconds];
+    bool dispatched = false;
+    while (NSEvent* event = [NSApp nextEventMatchingMask:NSEventMaskAny
+                                               untilDate:until
+                                                  inMode:NSDefaultRunLoopMode
+                                                 dequeue:YES]) {
+      [NSApp sendEvent:event];
+      dispatched = true;
+      until = [NSDate distantPast];
+    }
+    [NSApp updateWindows];
+    return dispatched;
+  }
+}
+
+// The run loop can't be waited on through a descriptor, the caller steps once per frame
+PollInfo Impl::getPollInfo() {
+  enterExternalLoop();
+  return {{}, std::chrono::milliseconds(16)};
+}
+
+// The main queue is drained in order by the run loop, the priority is not used
+void Impl::dispatch(DispatchTask&& task, [[maybe_unused]] DispatchPriority priority) {
   auto t = std::make_shared<DispatchTask>(std::move(task));
   dispatch_async(dispatch_get_main_queue(), ^{
     (*t)();
   });
-}
\ No newline at end of file
+}
+
+void Impl::dispatch(DispatchRequest& request) {
+  // Requests are queued rather than handed to the main queue, so that the ones still pending
+  // when the app is destroyed can be cancelled. Only the first request of a burst queues a block.
+  if (platform_->requests->push(request)) {
+    std::shared_ptr<TaskQueue> requests = platform_->requests;
+    dispatch_async(dispatch_get_main_queue(), ^{
+      requests->run();
+    });
+  }
+}
+
+void Impl::armTimer(TimerWheel::Clock::duration delay) { platform_->armTimer(delay); }
+
+using Platform = App::Impl::Platform;
+
+Platform::Platform(App::Impl& app) {
+  // A single run loop timer is kept and moved to the next expiry, its interval is never reached
+  App::Impl* impl = &app;
+  timer_ = CFRunLoopTimerCreateWithHandler(kCFAllocatorDefault, HUGE_VAL, HUGE_VAL, 0, 0,
+                                           ^(CFRunLoopTimerRef) {
+                                             impl->runTimers();
+                                           });
+  CFRunLoopAddTimer(CFRunLoopGetMain(), timer_, kCFRunLoopCommonModes);
+}
+
+Platform::~Platform() {
+  requests->cancel();
+  CFRunLoopTimerInvalidate(timer_);
+  CFRelease(timer_);
+}
+
+void Platform::armTimer(std::chrono::steady_clock::duration delay) {
+  const auto seconds = std::chrono::duration<double>(delay).count();
+  CFRunLoopTimerSetNextFireDate(timer_, CFAbsoluteTimeGetCurrent() + seconds);
+}
@@ -5,12 +5,27 @@
  * MIT License
  */
 
+#include <CoreFoundation/CoreFoundation.h>
+
+#include <memory>
+
 #include "interfaces/app_impl.h"
+#include "utils/task_queue.h"
 
 namespace deskgui {
   class App::Impl::Platform {
   public:
-    Platform() = default;
-    ~Platform() = default;
+    explicit Platform(App::Impl& app);
+    ~Platform();
+
+    // Main thread only: runs the app timers after the delay, replacing the previous delay
+    void armTimer(std::chrono::steady_clock::duration delay);
+
+    // Dispatch requests, run from the main queue. Shared with the queued blocks, which may run
+    // after the platform is destroyed and its pending requests are cancelled.
+    std::shared_ptr<TaskQueue> requests = std::make_shared<TaskQueue>();
+
+  private:
+    CFRunLoopTimerRef timer_{nullptr};
   };
 }  // namespace deskgui
\ No newline at end of file
@@ -152,3 +152,24 @@ void Impl::executeScript(const std::string& script) {
   [platform_->webview evaluateJavaScript:[NSString stringWithUTF8String:script.c_str()]
                        completionHandler:nil];
 }
+
+void Impl::evaluateScript(const std::string& script, ScriptCallback callback) {
+  auto pending = std::make_shared<ScriptCallback>(std::move(callback));
+  [platform_->webview evaluateJavaScript:[NSString stringWithUTF8String:script.c_str()]
+                       completionHandler:^(id result, NSError* error) {
+                         // Scalars are only serializable inside a container: serialize them in an
+                         // array and strip its brackets
+                         std::string json;
+                         if (!error && result) {
+                           NSArray* wrapped = @[ result ];
+                           if ([NSJSONSerialization isValidJSONObject:wrapped]) {
+                             NSData* data = [NSJSONSerialization dataWithJSONObject:wrapped
+                                                                            options:0
+                                                                              error:nil];
+                             json.assign(static_cast<const char*>(data.bytes) + 1,
+                                         data.length - 2);
+                           }
+                         }
+                         (*pending)(json);
+                       }];
+}
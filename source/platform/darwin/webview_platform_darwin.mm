@@ -59,8 +59,7 @@ NSString* const deskgui::kScriptMessageCallback = @"deskgui_callback";
   if (webView.URL) {
     NSString* urlString = [webView.URL absoluteString];
     const char* urlCString = [urlString UTF8String];
-    std::string url = urlCString ? urlCString : "";
-    webview_->events().emit(event::WebviewSourceChanged{url});
+    webview_->onSourceChanged(urlCString ? urlCString : "");
   }
 }
 
@@ -68,12 +67,9 @@ NSString* const deskgui::kScriptMessageCallback = @"deskgui_callback";
     decidePolicyForNavigationAction:(WKNavigationAction*)navigationAction
                     decisionHandler:(void (^)(WKNavigationActionPolicy))decisionHandler {
   NSString* urlString = navigationAction.request.URL.absoluteString;
-  std::string url = [urlString UTF8String];
+  const char* url = [urlString UTF8String];
 
-  event::WebviewNavigationStarting event{url};
-  webview_->events().emit(event);
-
-  if (event.isCancelled()) {
+  if (webview_->onNavigationStarting(url ? url : "")) {
     decisionHandler(WKNavigationActionPolicyCancel);
   } else {
     decisionHandler(WKNavigationActionPolicyAllow);
@@ -34,9 +34,14 @@ using namespace deskgui;
 }
 
 - (void)windowDidResize:(NSNotification*)notification {
+  _window->refreshGeometry();
   _window->events().emit(event::WindowResize{_window->getSize(PixelsType::kPhysical)});
 }
 
+- (void)windowDidMove:(NSNotification*)notification {
+  _window->refreshGeometry();
+}
+
 - (BOOL)windowShouldZoom:(NSWindow*)window toFrame:(NSRect)newFrame {
   return FALSE;
 }
@@ -66,6 +71,11 @@ using namespace deskgui;
                                              selector:@selector(windowDidResizeNotification:)
                                                  name:NSWindowDidResizeNotification
                                                object:_nativeWindow];
+
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(windowDidMoveNotification:)
+                                                 name:NSWindowDidMoveNotification
+                                               object:_nativeWindow];
   }
   return self;
 }
@@ -88,7 +98,12 @@ using namespace deskgui;
 }
 
 - (void)windowDidResizeNotification:(NSNotification*)notification {
+  _window->refreshGeometry();
   _window->events().emit(event::WindowResize{_window->getSize()});
 }
 
+- (void)windowDidMoveNotification:(NSNotification*)notification {
+  _window->refreshGeometry();
+}
+
 @end
@@ -5,6 +5,8 @@
  * MIT License
  */
 
+#include <algorithm>
+
 #include "app_platform_linux.h"
 #include "interfaces/app_impl.h"
 
@@ -12,8 +14,11 @@ using namespace deskgui;
 
 using Impl = App::Impl;
 
-Impl::Impl(const std::string& name) : platform_(std::make_unique<Impl::Platform>()), name_(name) {
-  mainThreadId_ = std::this_thread::get_id();
+Impl::Impl(const std::string& name, std::size_t backgroundThreads)
+    : platform_(std::make_unique<Impl::Platform>(*this)),
+      name_(name),
+      backgroundThreads_(backgroundThreads) {
+  mainThreadId_.store(std::this_thread::get_id(), std::memory_order_release);
 }
 
 Impl::~Impl() {
@@ -28,24 +33,169 @@ void Impl::run() {
   }
   isRunning_.store(true);
 
-  mainThreadId_ = std::this_thread::get_id();
+  mainThreadId_.store(std::this_thread::get_id(), std::memory_order_release);
   gtk_main();
 }
 
 void Impl::terminate() {
   if (isRunning_.load()) {
     isRunning_.store(false);
-    gtk_main_quit();
+    // An external loop stops polling on its own
+    if (gtk_main_level() > 0) {
+      gtk_main_quit();
+    }
+  }
+}
+
+bool Impl::poll(std::chrono::milliseconds timeout) {
+  if (!enterExternalLoop()) {
+    return false;
+  }
+  return platform_->iterate(timeout);
+}
+
+PollInfo Impl::getPollInfo() {
+  enterExternalLoop();
+  return platform_->query();
+}
+
+void Impl::dispatch(DispatchTask&& task, DispatchPriority priority) {
+  platform_->post(std::move(task), priority);
+}
+
+void Impl::dispatch(DispatchRequest& request) { platform_->post(request); }
+
+void Impl::armTimer(TimerWheel::Clock::duration delay) { platform_->armTimer(delay); }
+
+using Platform = App::Impl::Platform;
+
+Platform::Platform(App::Impl& app) {
+  static GSourceFuncs funcs = {nullptr, nullptr, &Platform::dispatchTasks, nullptr};
+
+  source_ = g_source_new(&funcs, sizeof(TaskSource));
+  reinterpret_cast<TaskSource*>(source_)->tasks = &tasks_;
+  g_source_set_priority(source_, G_PRIORITY_DEFAULT_IDLE);  // Same as the former g_idle_add
+  g_source_set_ready_time(source_, -1);
+  g_source_attach(source_, nullptr);
+
+  // Same priority as g_timeout_add, so timers are not delayed by a backlog of queued tasks
+  static GSourceFuncs timerFuncs = {nullptr, nullptr, &Platform::dispatchTimers, nullptr};
+
+  timerSource_ = g_source_new(&timerFuncs, sizeof(TimerSource));
+  reinterpret_cast<TimerSource*>(timerSource_)->app = &app;
+  g_source_set_priority(timerSource_, G_PRIORITY_DEFAULT);
+  g_source_set_ready_time(timerSource_, -1);
+  g_source_attach(timerSource_, nullptr);
+}
+
+Platform::~Platform() {
+  g_source_destroy(timerSource_);
+  g_source_unref(timerSource_);
+  g_source_destroy(source_);
+  g_source_unref(source_);
+}
+
+void Platform::post(DispatchTask&& task, DispatchPriority priority) {
+  // Only the first task of a burst wakes the main context up; g_source_set_ready_time is
+  // thread-safe and wakes up the context if it is sleeping in another thread
+  if (tasks_.push(std::move(task), priority)) {
+    g_source_set_ready_time(source_, 0);
+  }
+}
+
+void Platform::post(DispatchRequest& request) {
+  if (tasks_.push(request)) {
+    g_source_set_ready_time(source_, 0);
+  }
+}
+
+void Platform::armTimer(std::chrono::steady_clock::duration delay) {
+  const auto micros = std::chrono::ceil<std::chrono::microseconds>(delay).count();
+  g_source_set_ready_time(timerSource_, g_get_monotonic_time() + micros);
+}
+
+gboolean Platform::dispatchTimers(GSource* source, [[maybe_unused]] GSourceFunc callback,
+                                  [[maybe_unused]] gpointer user_data) {
+  // One-shot: runTimers arms the source again for the next expiry
+  g_source_set_ready_time(source, -1);
+  reinterpret_cast<TimerSource*>(source)->app->runTimers();
+  return G_SOURCE_CONTINUE;
+}
+
+gint Platform::prepare(gint& priority, gint& timeout) {
+  auto* context = g_main_context_default();
+  g_main_context_prepare(context, &priority);
+
+  if (pollFds_.empty()) {
+    pollFds_.resize(8);
   }
+  gint count;
+  while ((count = g_main_context_query(context, priority, &timeout, pollFds_.data(),
+                                       static_cast<gint>(pollFds_.size())))
+         > static_cast<gint>(pollFds_.size())) {
+    pollFds_.resize(static_cast<std::size_t>(count));
+  }
+  return count;
 }
 
-void Impl::dispatch(DispatchTask&& task) {
-  g_idle_add(
-      [](gpointer user_data) -> gboolean {
-        DispatchTask* task = static_cast<DispatchTask*>(user_data);
-        (*task)();
-        delete task;
-        return G_SOURCE_REMOVE;
-      },
-      new DispatchTask(std::move(task)));
-}
\ No newline at end of file
+bool Platform::iterate(std::chrono::milliseconds timeout) {
+  auto* context = g_main_context_default();
+  if (!g_main_context_acquire(context)) {
+    return false;
+  }
+
+  gint priority = 0;
+  gint sourceTimeout = -1;
+  const auto count = prepare(priority, sourceTimeout);
+
+  // Wait for the earliest of the caller's timeout and the next source timeout
+  auto pollTimeout = static_cast<gint>(
+      std::min<std::chrono::milliseconds::rep>(timeout.count(), G_MAXINT));
+  if (sourceTimeout >= 0) {
+    pollTimeout = std::min(pollTimeout, sourceTimeout);
+  }
+  g_main_context_get_poll_func(context)(pollFds_.data(), static_cast<guint>(count), pollTimeout);
+
+  const bool ready = g_main_context_check(context, priority, pollFds_.data(), count);
+  if (ready) {
+    g_main_context_dispatch(context);
+  }
+  g_main_context_release(context);
+  return ready;
+}
+
+PollInfo Platform::query() {
+  PollInfo info;
+  auto* context = g_main_context_default();
+  if (!g_main_context_acquire(context)) {
+    return info;
+  }
+
+  gint priority = 0;
+  gint timeout = -1;
+  const auto count = prepare(priority, timeout);
+  g_main_context_release(context);
+
+  // GIOCondition flags have the values of the poll(2) events
+  info.descriptors.reserve(static_cast<std::size_t>(count));
+  for (gint index = 0; index < count; ++index) {
+    info.descriptors.push_back(
+        {pollFds_[index].fd, static_cast<short>(pollFds_[index].events)});
+  }
+  if (timeout >= 0) {
+    info.timeout = std::chrono::milliseconds(timeout);
+  }
+  return info;
+}
+
+gboolean Platform::dispatchTasks(GSource* source, [[maybe_unused]] GSourceFunc callback,
+                                 [[maybe_unused]] gpointer user_data) {
+  // Disarmed before taking the tasks, so a task pushed meanwhile arms the source again
+  g_source_set_ready_time(source, -1);
+  if (reinterpret_cast<TaskSource*>(source)->tasks->run()) {
+    // Out of budget: the remaining tasks go on at the next iteration, after the sources of
+    // higher priority such as input and redraws have been dispatched
+    g_source_set_ready_time(source, 0);
+  }
+  return G_SOURCE_CONTINUE;
+}
@@ -9,12 +9,50 @@
 
 #include <gtk/gtk.h>
 
+#include <vector>
+
 #include "interfaces/app_impl.h"
+#include "utils/task_scheduler.h"
 
 namespace deskgui {
   class App::Impl::Platform {
   public:
-    Platform() = default;
-    ~Platform() = default;
+    explicit Platform(App::Impl& app);
+    ~Platform();
+
+    // Queue a task for the main loop, waking it up only if no task was pending
+    void post(DispatchTask&& task, DispatchPriority priority);
+    void post(DispatchRequest& request);
+
+    // Main thread only: runs the app timers after the delay, replacing the previous delay
+    void armTimer(std::chrono::steady_clock::duration delay);
+
+    // One iteration of the default main context, or what an external loop waits for before one
+    bool iterate(std::chrono::milliseconds timeout);
+    [[nodiscard]] PollInfo query();
+
+  private:
+    // GSource that stays attached to the default main context and runs every queued task
+    struct TaskSource {
+      GSource source;
+      TaskScheduler* tasks;
+    };
+
+    // GSource woken up at the next timer expiry
+    struct TimerSource {
+      GSource source;
+      App::Impl* app;
+    };
+
+    static gboolean dispatchTasks(GSource* source, GSourceFunc callback, gpointer user_data);
+    static gboolean dispatchTimers(GSource* source, GSourceFunc callback, gpointer user_data);
+
+    // Prepares the context and fills pollFds_, returning the number of descriptors
+    gint prepare(gint& priority, gint& timeout);
+
+    TaskScheduler tasks_;
+    GSource* source_{nullptr};
+    GSource* timerSource_{nullptr};
+    std::vector<GPollFD> pollFds_;
   };
 }  // namespace deskgui
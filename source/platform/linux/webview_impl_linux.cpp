@@ -144,3 +144,26 @@ void Impl::injectScript(const std::string& script) {
 void Impl::executeScript(const std::string& script) {
   webkit_web_view_run_javascript(platform_->webview, script.c_str(), nullptr, nullptr, nullptr);
 }
+
+void Impl::evaluateScript(const std::string& script, ScriptCallback callback) {
+  // The web view is kept alive by the pending operation, so the callback is always called
+  webkit_web_view_run_javascript(
+      platform_->webview, script.c_str(), nullptr,
+      [](GObject* object, GAsyncResult* asyncResult, gpointer userData) {
+        std::unique_ptr<ScriptCallback> callback(static_cast<ScriptCallback*>(userData));
+
+        std::string json;
+        WebKitJavascriptResult* result = webkit_web_view_run_javascript_finish(
+            WEBKIT_WEB_VIEW(object), asyncResult, nullptr);
+        if (result) {
+          JSCValue* value = webkit_javascript_result_get_js_value(result);
+          if (gchar* serialized = jsc_value_to_json(value, 0)) {
+            json = serialized;
+            g_free(serialized);
+          }
+          webkit_javascript_result_unref(result);
+        }
+        (*callback)(json);
+      },
+      new ScriptCallback(std::move(callback)));
+}
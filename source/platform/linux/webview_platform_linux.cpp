@@ -25,10 +25,7 @@ namespace deskgui {
 
         const gchar* uri = webkit_uri_request_get_uri(uriRequest);
 
-        event::WebviewNavigationStarting event{std::string(uri)};
-        impl->events().emit(event);
-
-        if (event.isCancelled()) {
+        if (impl->onNavigationStarting(uri ? uri : "")) {
           return TRUE;
         }
       }
@@ -43,7 +40,7 @@ namespace deskgui {
 
     if (loadEvent == WEBKIT_LOAD_COMMITTED) {
       const gchar* uri = webkit_web_view_get_uri(webview);
-      impl->events().emit(event::WebviewSourceChanged(std::string(uri)));
+      impl->onSourceChanged(uri ? uri : "");
     } else if (loadEvent == WEBKIT_LOAD_FINISHED) {
       impl->events().emit(event::WebviewContentLoaded(true));
     }
@@ -5,6 +5,7 @@
  * MIT License
  */
 
+#include <algorithm>
 #include <system_error>
 
 #include "window_platform_linux.h"
@@ -50,7 +51,11 @@ void Impl::setTitle(const std::string& title) {
   gtk_window_set_title(platform_->window, title.c_str());
 }
 
-std::string Impl::getTitle() const { return std::string(gtk_window_get_title(platform_->window)); }
+std::string Impl::getTitle() const {
+  // Null until a title has been set
+  const gchar* title = gtk_window_get_title(platform_->window);
+  return title ? std::string(title) : std::string();
+}
 
 void Impl::setSize(const ViewSize& size, PixelsType type) {
   auto newSize = size;
@@ -155,8 +160,10 @@ ViewRect Impl::getPosition(PixelsType type) const {
     width /= monitorScaleFactor_;
     height /= monitorScaleFactor_;
   }
-  return {static_cast<size_t>(x), static_cast<size_t>(y), static_cast<size_t>(x + width),
-          static_cast<size_t>(y + height)};
+  // Windows on a monitor left of or above the primary one have negative coordinates, which the
+  // unsigned ViewRect can't hold: they are clamped to the origin instead of wrapping around
+  const auto clamp = [](gint coordinate) { return static_cast<size_t>(std::max(coordinate, 0)); };
+  return {clamp(x), clamp(y), clamp(x + width), clamp(y + height)};
 }
 
 void Impl::setResizable(bool state) { gtk_window_set_resizable(platform_->window, state); }
@@ -38,11 +38,13 @@ gboolean Platform::onShow(GtkWidget* widget, Window::Impl* window) {
 // Callback function for the "configure-event" signal
 gboolean Platform::onConfigureEvent(GtkWidget* widget, [[maybe_unused]] GdkEventConfigure* event,
                                     Window::Impl* window) {
+  // Posted instead of emitted: a burst of configure events is delivered as one resize, with the
+  // latest size, after the signal handler returns
   if (window) {
-    window->platform()->throttle.trigger([window]() {
-      event::WindowResize resizeEvent({window->getSize()});
-      window->events().emit(resizeEvent);
-    });
+    // Only the geometry changes. It is read with the getters of the fresh path rather than from
+    // the event, which reports the frame geometry under client-side decorations.
+    window->refreshGeometry();
+    window->events().post<event::WindowResize>(window->cachedSize(PixelsType::kLogical));
   }
   return FALSE;
 }
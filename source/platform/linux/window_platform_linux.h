@@ -10,11 +10,8 @@
 #include <gtk/gtk.h>
 
 #include "interfaces/window_impl.h"
-#include "utils/throttle.h"
 
 namespace deskgui {
-  constexpr size_t kResizeThrottleInMs = 15;
-
   struct Window::Impl::Platform {
     GtkWindow* window;
     GtkWidget* container;
@@ -23,7 +20,5 @@ namespace deskgui {
     static gboolean onShow(GtkWidget* widget, Window::Impl* window);
     static gboolean onConfigureEvent(GtkWidget* widget, GdkEventConfigure* event,
                                      Window::Impl* window);
-
-    Throttle throttle{kResizeThrottleInMs};
   };
 }  // namespace deskgui
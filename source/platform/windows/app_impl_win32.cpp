@@ -7,6 +7,8 @@
 
 #include <windows.h>
 
+#include <algorithm>
+
 #include "app_platform_win32.h"
 #include "interfaces/app_impl.h"
 
@@ -14,8 +16,11 @@ using namespace deskgui;
 
 using Impl = App::Impl;
 
-Impl::Impl(const std::string& name) : platform_(std::make_unique<Impl::Platform>()), name_(name) {
-  mainThreadId_ = std::this_thread::get_id();
+Impl::Impl(const std::string& name, std::size_t backgroundThreads)
+    : platform_(std::make_unique<Impl::Platform>(*this)),
+      name_(name),
+      backgroundThreads_(backgroundThreads) {
+  mainThreadId_.store(std::this_thread::get_id(), std::memory_order_release);
 }
 
 Impl::~Impl() {
@@ -30,7 +35,7 @@ void Impl::run() {
   }
   isRunning_.store(true);
 
-  mainThreadId_ = std::this_thread::get_id();
+  mainThreadId_.store(std::this_thread::get_id(), std::memory_order_release);
 
   MSG msg = {};
   while (isRunning_.load()) {
@@ -50,8 +55,49 @@ void Impl::run() {
 
 void Impl::terminate() { isRunning_.store(false); }
 
-void Impl::dispatch(DispatchTask&& task) {
+bool Impl::poll(std::chrono::milliseconds timeout) {
+  if (!enterExternalLoop()) {
+    return false;
+  }
+
+  // Returns as soon as a message is queued, even if it was already seen by a previous peek
+  const auto millis = static_cast<DWORD>(std::min<std::chrono::milliseconds::rep>(
+      std::max<std::chrono::milliseconds::rep>(timeout.count(), 0), INFINITE - 1));
+  MsgWaitForMultipleObjectsEx(0, nullptr, millis, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+
+  bool dispatched = false;
+  MSG msg = {};
+  while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+    if (msg.message == WM_QUIT) {
+      Impl::terminate();
+      break;
+    }
+    TranslateMessage(&msg);
+    DispatchMessage(&msg);
+    dispatched = true;
+  }
+  return dispatched;
+}
+
+// The message queue can't be waited on through a descriptor, the caller steps once per frame
+PollInfo Impl::getPollInfo() {
+  enterExternalLoop();
+  return {{}, std::chrono::milliseconds(16)};
+}
+
+// Posted messages already run in order ahead of input and painting, the priority is not used
+void Impl::dispatch(DispatchTask&& task, [[maybe_unused]] DispatchPriority priority) {
   auto* heapTask = new DispatchTask(std::move(task));
   PostMessage(platform_->messageWindow, Platform::windowMessage, 0,
               reinterpret_cast<LPARAM>(heapTask));
-}
\ No newline at end of file
+}
+
+void Impl::dispatch(DispatchRequest& request) {
+  // Requests are queued rather than posted as messages, so that the ones still pending when the
+  // app is destroyed can be cancelled. Only the first request of a burst posts a message.
+  if (platform_->requests.push(request)) {
+    PostMessage(platform_->messageWindow, Platform::requestMessage, 0, 0);
+  }
+}
+
+void Impl::armTimer(TimerWheel::Clock::duration delay) { platform_->armTimer(delay); }
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 #include "app_platform_win32.h"
 
+#include <algorithm>
+
 using namespace deskgui;
 
 using Platform = App::Impl::Platform;
@@ -20,10 +22,25 @@ LRESULT CALLBACK Platform::windowMessageProc(HWND hwnd, UINT uMsg, WPARAM wParam
     }
     return 0;
   }
+  if (uMsg == Platform::requestMessage) {
+    // Posted once per burst of requests
+    if (auto* app = reinterpret_cast<App::Impl*>(GetWindowLongPtr(hwnd, GWLP_USERDATA))) {
+      app->platform_->requests.run();
+    }
+    return 0;
+  }
+  if (uMsg == WM_TIMER && wParam == Platform::kTimerId) {
+    // One-shot: runTimers arms the timer again for the next expiry
+    KillTimer(hwnd, Platform::kTimerId);
+    if (auto* app = reinterpret_cast<App::Impl*>(GetWindowLongPtr(hwnd, GWLP_USERDATA))) {
+      app->runTimers();
+    }
+    return 0;
+  }
   return DefWindowProc(hwnd, uMsg, wParam, lParam);
 }
 
-Platform::Platform() {
+Platform::Platform(App::Impl& app) {
   // Register class for the message-only window
   WNDCLASSEX wc = {sizeof(WNDCLASSEX),       0,       windowMessageProc, 0,       0,
                    GetModuleHandle(nullptr), nullptr, nullptr,           nullptr, nullptr,
@@ -33,4 +50,17 @@ Platform::Platform() {
   // Create the message-only window
   messageWindow = CreateWindowEx(0, L"MessageWindowClass", L"MessageWindow", 0, 0, 0, 0, 0,
                                  HWND_MESSAGE, nullptr, nullptr, nullptr);
+  SetWindowLongPtr(messageWindow, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(&app));
+}
+
+Platform::~Platform() {
+  // No request message is received afterwards, the queue cancels the requests left
+  DestroyWindow(messageWindow);
+}
+
+void Platform::armTimer(std::chrono::steady_clock::duration delay) {
+  // SetTimer replaces the delay of a timer with the same id
+  const auto millis = std::chrono::ceil<std::chrono::milliseconds>(delay).count();
+  SetTimer(messageWindow, kTimerId, std::max<UINT>(static_cast<UINT>(millis), USER_TIMER_MINIMUM),
+           nullptr);
 }
@@ -8,16 +8,26 @@
 #include <windows.h>
 
 #include "interfaces/app_impl.h"
+#include "utils/task_queue.h"
 
 namespace deskgui {
   class App::Impl::Platform {
   public:
-    Platform();
-    ~Platform() = default;
+    explicit Platform(App::Impl& app);
+    ~Platform();
+
+    // Main thread only: runs the app timers after the delay, replacing the previous delay
+    void armTimer(std::chrono::steady_clock::duration delay);
 
     static LRESULT CALLBACK windowMessageProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
     static const inline UINT windowMessage = RegisterWindowMessageW(L"window_message");
+    static const inline UINT requestMessage = RegisterWindowMessageW(L"request_message");
+    static constexpr UINT_PTR kTimerId = 1;
 
     HWND messageWindow;
+
+    // Dispatch requests, run when requestMessage is received. Destroyed with the platform, which
+    // cancels the requests still queued.
+    TaskQueue requests;
   };
 }  // namespace deskgui
\ No newline at end of file
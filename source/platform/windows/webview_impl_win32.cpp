@@ -54,10 +54,8 @@ Impl::Impl(const std::string& name, AppHandler* appHandler, void* window,
           [=](ICoreWebView2* sender, ICoreWebView2NavigationStartingEventArgs* args) -> HRESULT {
             wil::unique_cotaskmem_string uri;
             args->get_Uri(&uri);
-            event::WebviewNavigationStarting event(ws2s(uri.get()));
-            events_.emit(event);
 
-            if (event.isCancelled()) {
+            if (onNavigationStarting(ws2s(uri.get()))) {
               sender->Stop();
             }
             return S_OK;
@@ -101,7 +99,7 @@ Impl::Impl(const std::string& name, AppHandler* appHandler, void* window,
       Callback<ICoreWebView2SourceChangedEventHandler>(
           [=]([[maybe_unused]] ICoreWebView2* sender,
               [[maybe_unused]] ICoreWebView2SourceChangedEventArgs* args) -> HRESULT {
-            events_.emit(event::WebviewSourceChanged(getUrl()));
+            onSourceChanged(getUrl());
             return S_OK;
           })
           .Get(),
@@ -316,4 +314,19 @@ void Impl::injectScript(const std::string& script) {
 
 void Impl::executeScript(const std::string& script) {
   platform_->webview->ExecuteScript(s2ws(script).c_str(), nullptr);
+}
+
+void Impl::evaluateScript(const std::string& script, ScriptCallback callback) {
+  platform_->webview->ExecuteScript(
+      s2ws(script).c_str(),
+      Callback<ICoreWebView2ExecuteScriptCompletedHandler>(
+          [callback = std::move(callback)](HRESULT errorCode, LPCWSTR resultObjectAsJson) {
+            if (SUCCEEDED(errorCode) && resultObjectAsJson) {
+              callback(ws2s(resultObjectAsJson));
+            } else {
+              callback("");
+            }
+            return S_OK;
+          })
+          .Get());
 }
\ No newline at end of file
@@ -43,7 +43,11 @@ bool Platform::processWindowMessage(Window::Impl *window, HWND hwnd, UINT uMsg,
       event::WindowResize resizeEvent(window->getSize(PixelsType::kPhysical));
       window->events().emit(resizeEvent);
     } break;
+    case WM_MOVE: {
+      window->refreshGeometry();
+    } break;
     case WM_SIZE: {
+      window->refreshGeometry();
       window->platform()->throttle.trigger([window]() {
         event::WindowResize resizeEvent(window->getSize(PixelsType::kPhysical));
         window->events().emit(resizeEvent);
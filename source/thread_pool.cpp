@@ -0,0 +1,166 @@
+/**
+ * deskgui - A powerful and flexible C++ library to create web-based desktop applications.
+ *
+ * Copyright (c) 2023 deskgui
+ * MIT License
+ */
+
+#include <deskgui/thread_pool.h>
+
+#include <algorithm>
+
+using namespace deskgui;
+
+namespace {
+  // Pool and worker running on the current thread, so that tasks submitted from a worker stay in
+  // its own deque
+  thread_local const ThreadPool* currentPool = nullptr;
+  thread_local std::size_t currentWorker = 0;
+
+  constexpr std::size_t kMaxSharedThreads = 4;
+
+  // Tasks behave the same whether a worker or the submitting thread runs them
+  void runDiscardingExceptions(const ThreadPool::Task& task) {
+    try {
+      task();
+    } catch (...) {
+      // Nobody is waiting for the result of a task
+    }
+  }
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t threads, std::size_t capacity)
+    : capacity_(std::max<std::size_t>(capacity, 1)) {
+  threads = std::max<std::size_t>(threads, 1);
+
+  workers_.reserve(threads);
+  for (std::size_t index = 0; index < threads; ++index) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (std::size_t index = 0; index < threads; ++index) {
+    workers_[index]->thread = std::thread([this, index] { run(index); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  workAvailable_.notify_all();
+  spaceAvailable_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+bool ThreadPool::submit(Task&& task, QueueFullPolicy policy) {
+  const bool onWorker = currentPool == this;
+
+  // Reserve a place in the queue before pushing, so pending_ never exceeds capacity_
+  auto pending = pending_.load(std::memory_order_relaxed);
+  while (pending >= capacity_
+         || !pending_.compare_exchange_weak(pending, pending + 1, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+    if (pending < capacity_) {
+      continue;
+    }
+    if (policy == QueueFullPolicy::kDrop) {
+      return false;
+    }
+    if (policy == QueueFullPolicy::kRunInCaller || onWorker) {
+      runDiscardingExceptions(task);
+      return true;
+    }
+
+    std::unique_lock lock(mutex_);
+    ++blocked_;
+    spaceAvailable_.wait(lock, [this, &pending] {
+      pending = pending_.load(std::memory_order_acquire);
+      return stopping_ || pending < capacity_;
+    });
+    --blocked_;
+    if (stopping_) {
+      lock.unlock();
+      runDiscardingExceptions(task);
+      return true;
+    }
+  }
+
+  auto& worker = *workers_[onWorker ? currentWorker
+                                    : next_.fetch_add(1, std::memory_order_relaxed)
+                                          % workers_.size()];
+  {
+    std::lock_guard lock(worker.mutex);
+    worker.tasks.push_back(std::move(task));
+  }
+  ++queued_;
+
+  // Workers announce that they sleep before checking queued_, so if none is seen sleeping here,
+  // the next one to sleep will see this task
+  if (sleeping_ > 0) {
+    {
+      std::lock_guard lock(mutex_);
+    }
+    workAvailable_.notify_one();
+  }
+  return true;
+}
+
+bool ThreadPool::pop(std::size_t index, Task& task) {
+  for (std::size_t offset = 0; offset < workers_.size(); ++offset) {
+    auto& worker = *workers_[(index + offset) % workers_.size()];
+    std::lock_guard lock(worker.mutex);
+    if (worker.tasks.empty()) {
+      continue;
+    }
+
+    if (offset == 0) {
+      task = std::move(worker.tasks.front());
+      worker.tasks.pop_front();
+    } else {
+      task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+    }
+    --queued_;
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::run(std::size_t index) {
+  currentPool = this;
+  currentWorker = index;
+
+  Task task;
+  while (true) {
+    if (pop(index, task)) {
+      --pending_;
+      if (blocked_ > 0) {
+        {
+          std::lock_guard lock(mutex_);
+        }
+        spaceAvailable_.notify_one();
+      }
+
+      runDiscardingExceptions(task);
+      task = Task{};
+      continue;
+    }
+
+    std::unique_lock lock(mutex_);
+    ++sleeping_;
+    workAvailable_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+    --sleeping_;
+    if (stopping_ && queued_ == 0) {
+      return;
+    }
+  }
+}
+
+ThreadPool& ThreadPool::shared() {
+  static ThreadPool pool(
+      std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, kMaxSharedThreads));
+  return pool;
+}
@@ -10,7 +10,6 @@
 #include <deskgui/app_handler.h>
 
 #include <functional>
-#include <future>
 #include <memory>
 #include <tuple>
 #include <type_traits>
@@ -19,42 +18,81 @@
 namespace deskgui {
   namespace utils {
 
+    // Runs Func on the main thread without waiting for it. Calls posted from the same thread run
+    // in order, and before any later dispatch() from that thread. Calls made from another thread
+    // are fire-and-forget: nobody waits for them, so their exceptions are discarded instead of
+    // escaping into the main loop.
     template <auto Func, typename Impl, typename... Args>
-    auto dispatch(const std::shared_ptr<Impl>& impl, Args&&... args) {
-      using ReturnType = std::invoke_result_t<decltype(Func), Impl*, Args...>;
-
-      auto defaultReturn = []() -> ReturnType {
-        if constexpr (!std::is_void_v<ReturnType>) {
-          return ReturnType{};
-        } else {
-          return;
-        }
-      };
-
-      if (!impl) return defaultReturn();
+    void post(const std::shared_ptr<Impl>& impl, Args&&... args) {
+      if (!impl) return;
 
       auto* app = reinterpret_cast<AppHandler*>(impl->application());
-      if (!app) return defaultReturn();
+      if (!app) return;
 
       if (app->isMainThread()) {
-        return std::invoke(Func, impl.get(), std::forward<Args>(args)...);
+        std::invoke(Func, impl.get(), std::forward<Args>(args)...);
+        return;
       }
 
       std::weak_ptr<Impl> weakImpl = impl;
 
-      return app->dispatchOnMainThread([weakImpl,
-                                        argsTuple = std::make_tuple(std::forward<Args>(args)...),
-                                        defaultReturn]() mutable {
-        auto sharedImpl = weakImpl.lock();
-        if (!sharedImpl) return defaultReturn();
-
-        return std::apply(
-            [&sharedImpl](auto&&... unpackedArgs) {
-              return std::invoke(Func, sharedImpl.get(),
-                                 std::forward<decltype(unpackedArgs)>(unpackedArgs)...);
-            },
-            std::move(argsTuple));
-      });
+      app->postOnMainThread(
+          [weakImpl, argsTuple = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+            auto sharedImpl = weakImpl.lock();
+            if (!sharedImpl) return;
+
+            try {
+              std::apply(
+                  [&sharedImpl](auto&&... unpackedArgs) {
+                    std::invoke(Func, sharedImpl.get(),
+                                std::forward<decltype(unpackedArgs)>(unpackedArgs)...);
+                  },
+                  std::move(argsTuple));
+            } catch (...) {
+              // Discarded, see above
+            }
+          });
+    }
+
+    // Runs Func on the main thread and returns its result. Methods returning void are posted
+    // instead, so setters called from other threads don't wait for the main loop.
+    template <auto Func, typename Impl, typename... Args>
+    auto dispatch(const std::shared_ptr<Impl>& impl, Args&&... args) {
+      using ReturnType = std::invoke_result_t<decltype(Func), Impl*, Args...>;
+
+      if constexpr (std::is_void_v<ReturnType>) {
+        post<Func>(impl, std::forward<Args>(args)...);
+      } else {
+        auto defaultReturn = []() -> ReturnType { return ReturnType{}; };
+
+        if (!impl) return defaultReturn();
+
+        auto* app = reinterpret_cast<AppHandler*>(impl->application());
+        if (!app) return defaultReturn();
+
+        if (app->isMainThread()) {
+          return std::invoke(Func, impl.get(), std::forward<Args>(args)...);
+        }
+
+        // The caller blocks until the call has run, so the arguments can be forwarded by reference
+        // instead of being copied. The impl is not kept alive by the caller: its window may be
+        // destroyed on the main thread before the request runs.
+        std::weak_ptr<Impl> weakImpl = impl;
+
+        return app->dispatchOnMainThread(
+            [weakImpl, argsTuple = std::forward_as_tuple(std::forward<Args>(args)...),
+             defaultReturn]() mutable {
+              auto sharedImpl = weakImpl.lock();
+              if (!sharedImpl) return defaultReturn();
+
+              return std::apply(
+                  [&sharedImpl](auto&&... unpackedArgs) {
+                    return std::invoke(Func, sharedImpl.get(),
+                                       std::forward<decltype(unpackedArgs)>(unpackedArgs)...);
+                  },
+                  std::move(argsTuple));
+            });
+      }
     }
 
   }  // namespace utils
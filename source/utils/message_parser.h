@@ -0,0 +1,182 @@
+/**
+ * deskgui - A powerful and flexible C++ library to create web-based desktop applications.
+ *
+ * Copyright (c) 2023 deskgui
+ * MIT License
+ */
+
+#pragma once
+
+#include <rapidjson/document.h>
+#include <rapidjson/reader.h>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace deskgui {
+
+  /**
+   * MessageParser - Single pass parser for the JSON messages posted by the web content.
+   *
+   * The message is copied to a reused buffer and parsed in situ, so strings are not copied, and
+   * values are allocated from a pool whose first chunk is reused from one message to the next.
+   * The text of the top level members is sliced out of the original message while parsing, so
+   * handlers expecting JSON text get it without serializing the value again.
+   *
+   * The parsed values and the slices are valid until the next call to parse().
+   */
+  class MessageParser {
+  public:
+    MessageParser() = default;
+
+    MessageParser(const MessageParser&) = delete;
+    MessageParser& operator=(const MessageParser&) = delete;
+
+    // Returns false if the message is not a JSON object, in which case it has no members to read
+    bool parse(std::string_view message) {
+      // Values live in the pool, they don't have to be destroyed before it is cleared
+      document_.SetNull();
+      allocator_.Clear();
+
+      message_ = message;
+      members_.clear();
+
+      text_.assign(message.begin(), message.end());
+      text_.push_back('\0');
+
+      rapidjson::InsituStringStream stream(text_.data());
+      Generator generator{*this, stream};
+      document_.Populate(generator);
+      return generator.succeeded && document_.IsObject();
+    }
+
+    [[nodiscard]] const rapidjson::Value& document() const { return document_; }
+
+    // String member of the message, empty if missing
+    [[nodiscard]] std::string_view string(const char* name) const {
+      const auto it = document_.FindMember(name);
+      if (it == document_.MemberEnd() || !it->value.IsString()) {
+        return {};
+      }
+      return {it->value.GetString(), it->value.GetStringLength()};
+    }
+
+    // Member of the message, null if missing
+    [[nodiscard]] const rapidjson::Value* value(const char* name) const {
+      const auto it = document_.FindMember(name);
+      return it != document_.MemberEnd() ? &it->value : nullptr;
+    }
+
+    // JSON text of a member as written in the message, empty if missing
+    [[nodiscard]] std::string_view raw(std::string_view name) const {
+      for (const auto& member : members_) {
+        if (member.name == name) {
+          return message_.substr(member.begin, member.end - member.begin);
+        }
+      }
+      return {};
+    }
+
+  private:
+    static constexpr std::size_t kPoolSize = 4096;
+
+    // Position of a top level member value in the message
+    struct RawMember {
+      std::string_view name;
+      std::size_t begin;
+      std::size_t end;
+    };
+
+    // Feeds the document while recording where the top level values start and end in the message
+    struct Handler {
+      MessageParser& parser;
+      rapidjson::Document& document;
+      rapidjson::InsituStringStream& stream;
+      int depth = 0;
+      bool memberNext = false;  // A top level key has just been read
+      int memberDepth = 0;      // Depth of the top level container being read, if any
+
+      bool Null() { return value() && document.Null(); }
+      bool Bool(bool b) { return value() && document.Bool(b); }
+      bool Int(int i) { return value() && document.Int(i); }
+      bool Uint(unsigned i) { return value() && document.Uint(i); }
+      bool Int64(std::int64_t i) { return value() && document.Int64(i); }
+      bool Uint64(std::uint64_t i) { return value() && document.Uint64(i); }
+      bool Double(double d) { return value() && document.Double(d); }
+      bool RawNumber(const char* str, rapidjson::SizeType length, bool copy) {
+        return value() && document.RawNumber(str, length, copy);
+      }
+      bool String(const char* str, rapidjson::SizeType length, bool copy) {
+        return value() && document.String(str, length, copy);
+      }
+
+      bool StartObject() { return start() && document.StartObject(); }
+      bool StartArray() { return start() && document.StartArray(); }
+      bool EndObject(rapidjson::SizeType count) { return end() && document.EndObject(count); }
+      bool EndArray(rapidjson::SizeType count) { return end() && document.EndArray(count); }
+
+      bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+        if (depth == 1) {
+          memberNext = true;
+          // The key is followed by a colon and whitespace only. In situ, the key itself stays
+          // valid in the buffer.
+          const auto begin = parser.message_.find_first_not_of(" \t\n\r:", stream.Tell());
+          parser.members_.push_back({std::string_view(str, length), begin, begin});
+        }
+        return document.Key(str, length, copy);
+      }
+
+      // The stream is right past a scalar when it is reported
+      bool value() {
+        if (memberNext) {
+          memberNext = false;
+          parser.members_.back().end = stream.Tell();
+        }
+        return true;
+      }
+
+      bool start() {
+        if (memberNext) {
+          memberNext = false;
+          memberDepth = depth + 1;
+        }
+        ++depth;
+        return true;
+      }
+
+      // The stream is right past the closing bracket when the container end is reported
+      bool end() {
+        if (depth == memberDepth) {
+          memberDepth = 0;
+          parser.members_.back().end = stream.Tell();
+        }
+        --depth;
+        return true;
+      }
+    };
+
+    struct Generator {
+      MessageParser& parser;
+      rapidjson::InsituStringStream& stream;
+      bool succeeded = false;
+
+      bool operator()(rapidjson::Document& document) {
+        Handler handler{parser, document, stream};
+        succeeded = !parser.reader_.Parse<rapidjson::kParseInsituFlag>(stream, handler).IsError();
+        return succeeded;
+      }
+    };
+
+    std::string_view message_;
+    std::vector<char> text_;
+    std::vector<RawMember> members_;
+
+    std::array<char, kPoolSize> pool_{};
+    rapidjson::MemoryPoolAllocator<> allocator_{pool_.data(), pool_.size()};
+    rapidjson::Document document_{&allocator_};
+    rapidjson::Reader reader_;
+  };
+
+}  // namespace deskgui
@@ -0,0 +1,148 @@
+/**
+ * deskgui - A powerful and flexible C++ library to create web-based desktop applications.
+ *
+ * Copyright (c) 2023 deskgui
+ * MIT License
+ */
+
+#pragma once
+
+#include <deskgui/app_handler.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <utility>
+
+namespace deskgui {
+
+  /**
+   * TaskQueue - Lock-free multi-producer single-consumer queue of dispatch requests.
+   *
+   * Producers push with a single compare-and-swap and learn whether the queue was empty, so the
+   * consumer only has to be woken up once per burst of requests. The consumer takes every queued
+   * request at once and runs them in push order. Requests are linked through their next member:
+   * pushing a request owned by the caller does not allocate.
+   */
+  class TaskQueue {
+  public:
+    TaskQueue() = default;
+    ~TaskQueue() { cancel(); }
+
+    TaskQueue(const TaskQueue&) = delete;
+    TaskQueue& operator=(const TaskQueue&) = delete;
+
+    /**
+     * push - Queues a request, which must stay alive until it has run. Safe to call from any
+     * thread.
+     *
+     * @return True if the queue was empty, in which case the consumer must be woken up.
+     */
+    bool push(DispatchRequest& request) {
+      auto* head = head_.load(std::memory_order_relaxed);
+      do {
+        request.next = head;
+      } while (!head_.compare_exchange_weak(head, &request, std::memory_order_release,
+                                            std::memory_order_relaxed));
+      return head == nullptr;
+    }
+
+    /**
+     * push - Queues a task, owned by the queue until it has run. Safe to call from any thread.
+     *
+     * @return True if the queue was empty, in which case the consumer must be woken up.
+     */
+    bool push(DispatchTask&& task) { return push(*new OwnedTask(std::move(task))); }
+
+    /**
+     * run - Runs the requests queued so far, in push order. Only the consumer thread may call
+     * it. Requests pushed while running are left for the next call, and so are the remaining
+     * requests if one throws.
+     */
+    void run() {
+      take();
+      while (pending_) {
+        runNext();
+      }
+    }
+
+    /**
+     * run - Runs the requests queued so far, in push order, until the deadline has passed.
+     *
+     * @return True if some requests were left for the next call.
+     */
+    bool run(std::chrono::steady_clock::time_point deadline) {
+      take();
+      while (pending_) {
+        runNext();
+        if (std::chrono::steady_clock::now() >= deadline) {
+          break;
+        }
+      }
+      return pending_ != nullptr;
+    }
+
+    /**
+     * cancel - Cancels the requests queued so far instead of running them: owned tasks are
+     * deleted, and callers blocked in dispatchOnMainThread() or coroutines suspended on
+     * App::mainThread() are released. Only the consumer thread may call it.
+     */
+    void cancel() {
+      cancelAll(head_.exchange(nullptr, std::memory_order_acquire));
+      cancelAll(std::exchange(pending_, nullptr));
+    }
+
+  private:
+    // Moves the pushed requests after the pending ones
+    void take() {
+      // Requests are pushed newest first, reverse them to keep push order
+      DispatchRequest* requests = nullptr;
+      for (auto* request = head_.exchange(nullptr, std::memory_order_acquire); request;) {
+        auto* next = request->next;
+        request->next = requests;
+        requests = request;
+        request = next;
+      }
+
+      auto** tail = &pending_;
+      while (*tail) {
+        tail = &(*tail)->next;
+      }
+      *tail = requests;
+    }
+
+    void runNext() {
+      // The request may be gone once it has run
+      auto* request = std::exchange(pending_, pending_->next);
+      request->run(*request);
+    }
+
+    struct OwnedTask : DispatchRequest {
+      explicit OwnedTask(DispatchTask&& task)
+          : DispatchRequest{&OwnedTask::execute, &OwnedTask::discard}, task(std::move(task)) {}
+
+      static void execute(DispatchRequest& request) {
+        std::unique_ptr<OwnedTask> self(static_cast<OwnedTask*>(&request));
+        self->task();
+      }
+
+      static void discard(DispatchRequest& request) { delete static_cast<OwnedTask*>(&request); }
+
+      DispatchTask task;
+    };
+
+    // Requests without a cancel hook are dropped
+    static void cancelAll(DispatchRequest* request) {
+      while (request) {
+        auto* current = std::exchange(request, request->next);
+        if (current->cancel) {
+          current->cancel(*current);
+        }
+      }
+    }
+
+    std::atomic<DispatchRequest*> head_{nullptr};  // Newest first
+    DispatchRequest* pending_ = nullptr;           // Taken by run() and not run yet, oldest first
+  };
+
+}  // namespace deskgui
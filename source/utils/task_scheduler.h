@@ -0,0 +1,76 @@
+/**
+ * deskgui - A powerful and flexible C++ library to create web-based desktop applications.
+ *
+ * Copyright (c) 2023 deskgui
+ * MIT License
+ */
+
+#pragma once
+
+#include <deskgui/app_handler.h>
+
+#include <chrono>
+
+#include "utils/task_queue.h"
+
+namespace deskgui {
+
+  /**
+   * TaskScheduler - Queues the dispatch requests of each priority class and runs them within a
+   * time budget per main loop iteration.
+   *
+   * Immediate requests all run on every call. Normal requests then run until the budget is spent,
+   * and background requests only once no normal request is left, so that a flood of low-value
+   * updates can't delay the main loop's own work, such as redraws, for long.
+   */
+  class TaskScheduler {
+  public:
+    static constexpr std::chrono::milliseconds kFrameBudget{4};
+
+    /**
+     * push - Queues a request in the class it names. Safe to call from any thread.
+     *
+     * @return True if its class was empty, in which case the consumer must be woken up.
+     */
+    bool push(DispatchRequest& request) { return queue(request.priority).push(request); }
+
+    /**
+     * push - Queues a task in the given class. Safe to call from any thread.
+     *
+     * @return True if the class was empty, in which case the consumer must be woken up.
+     */
+    bool push(DispatchTask&& task, DispatchPriority priority) {
+      return queue(priority).push(std::move(task));
+    }
+
+    /**
+     * run - Runs the queued requests until the budget is spent. Only the consumer thread may
+     * call it.
+     *
+     * @return True if some requests were left for the next call.
+     */
+    bool run(std::chrono::steady_clock::duration budget = kFrameBudget) {
+      const auto deadline = std::chrono::steady_clock::now() + budget;
+
+      immediate_.run();
+      return normal_.run(deadline) || background_.run(deadline);
+    }
+
+  private:
+    TaskQueue& queue(DispatchPriority priority) {
+      switch (priority) {
+        case DispatchPriority::kImmediate:
+          return immediate_;
+        case DispatchPriority::kBackground:
+          return background_;
+        default:
+          return normal_;
+      }
+    }
+
+    TaskQueue immediate_;
+    TaskQueue normal_;
+    TaskQueue background_;
+  };
+
+}  // namespace deskgui
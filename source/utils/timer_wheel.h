@@ -0,0 +1,229 @@
+/**
+ * deskgui - A powerful and flexible C++ library to create web-based desktop applications.
+ *
+ * Copyright (c) 2023 deskgui
+ * MIT License
+ */
+
+#pragma once
+
+#include <deskgui/types.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace deskgui {
+
+  /**
+   * TimerWheel - Hierarchical timing wheel with a resolution of one millisecond.
+   *
+   * Four levels of 64 slots hold the timers expiring within 64 ms, 4 s, 4 min and 4.6 h; later
+   * timers wait in the last level. A level's slot is cascaded down to the level below when the
+   * lower level wraps around, so adding, cancelling and expiring a timer are all constant time,
+   * whatever the number of timers.
+   *
+   * Cancelled and rescheduled timers are removed lazily: their slot entries are skipped once
+   * reached. Not thread-safe.
+   */
+  class TimerWheel {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::shared_ptr<TimerCallback>;
+
+    explicit TimerWheel(Clock::time_point start = Clock::now()) : start_(start) {}
+
+    /**
+     * add - Schedules a timer. Timers never expire before their expiry time.
+     *
+     * @param interval Period of the timer once it has expired, zero for a one-shot timer.
+     */
+    void add(UniqueId id, Clock::time_point expiry, Clock::duration interval,
+             TimerCallback callback) {
+      auto& timer = timers_[id];
+      timer.expiry = std::max(toTick(expiry, true), current_ + 1);
+      timer.interval = std::max<std::uint64_t>(toTicks(interval), interval.count() > 0 ? 1 : 0);
+      timer.callback = std::make_shared<TimerCallback>(std::move(callback));
+      insert(id, timer.expiry);
+    }
+
+    // Returns false if no such timer is scheduled
+    bool cancel(UniqueId id) { return timers_.erase(id) > 0; }
+
+    [[nodiscard]] bool empty() const { return timers_.empty(); }
+
+    /**
+     * advance - Moves the wheel to now and collects the timers expired meanwhile, in expiry
+     * order. Their callbacks are retrieved with fire(), so callbacks may cancel timers due at the
+     * same time.
+     */
+    void advance(Clock::time_point now, std::vector<UniqueId>& expired) {
+      const auto target = toTick(now, false);
+      while (current_ < target) {
+        // Jump over the ticks at which no slot is reached
+        const auto next = timers_.empty() ? std::nullopt : nextTick();
+        if (!next || *next > target) {
+          current_ = target;
+          break;
+        }
+
+        current_ = *next;
+        for (std::size_t level = kLevels - 1; level > 0; --level) {
+          if (current_ % span(level) == 0) {
+            cascade(level);
+          }
+        }
+
+        auto& slot = slots_[0][current_ % kSlots];
+        auto entries = std::move(slot);
+        slot.clear();
+        for (const auto& entry : entries) {
+          if (isScheduled(entry)) {
+            expired.push_back(entry.id);
+          }
+        }
+      }
+    }
+
+    /**
+     * fire - Takes the callback of an expired timer, rescheduling it if it is an interval.
+     *
+     * @return The callback, or null if the timer has been cancelled meanwhile.
+     */
+    [[nodiscard]] Callback fire(UniqueId id) {
+      auto it = timers_.find(id);
+      if (it == timers_.end()) {
+        return nullptr;
+      }
+
+      auto& timer = it->second;
+      if (timer.interval == 0) {
+        auto callback = std::move(timer.callback);
+        timers_.erase(it);
+        return callback;
+      }
+
+      // Late intervals skip the periods they missed instead of firing in a burst
+      timer.expiry += timer.interval;
+      if (timer.expiry <= current_) {
+        timer.expiry = current_ + timer.interval;
+      }
+      insert(id, timer.expiry);
+      return timer.callback;
+    }
+
+    /**
+     * nextExpiry - Time the wheel next has to be advanced to, which may be earlier than the next
+     * expiry when timers have to be cascaded first.
+     */
+    [[nodiscard]] std::optional<Clock::time_point> nextExpiry() const {
+      if (timers_.empty()) {
+        return std::nullopt;
+      }
+      if (auto next = nextTick()) {
+        return start_ + std::chrono::milliseconds(*next);
+      }
+      return std::nullopt;
+    }
+
+  private:
+    static constexpr std::size_t kLevels = 4;
+    static constexpr std::uint64_t kSlots = 64;
+
+    struct Timer {
+      std::uint64_t expiry = 0;
+      std::uint64_t interval = 0;
+      Callback callback;
+    };
+
+    struct Entry {
+      UniqueId id;
+      std::uint64_t expiry;
+    };
+
+    // Ticks covered by one slot of the level
+    static constexpr std::uint64_t span(std::size_t level) {
+      return std::uint64_t{1} << (6 * level);
+    }
+
+    std::uint64_t toTicks(Clock::duration duration) const {
+      return static_cast<std::uint64_t>(
+          std::chrono::ceil<std::chrono::milliseconds>(duration).count());
+    }
+
+    std::uint64_t toTick(Clock::time_point time, bool roundUp) const {
+      if (time <= start_) {
+        return 0;
+      }
+      const auto elapsed = time - start_;
+      return roundUp ? toTicks(elapsed)
+                     : static_cast<std::uint64_t>(
+                         std::chrono::floor<std::chrono::milliseconds>(elapsed).count());
+    }
+
+    // First tick at which a slot holding entries is reached
+    std::optional<std::uint64_t> nextTick() const {
+      std::optional<std::uint64_t> next;
+      for (std::size_t level = 0; level < kLevels; ++level) {
+        // The slots of a level are reached in turn, every span(level) ticks
+        const auto first = (current_ / span(level) + 1) * span(level);
+        for (std::uint64_t slot = 0; slot < kSlots; ++slot) {
+          const auto tick = first + slot * span(level);
+          if (next && tick >= *next) {
+            break;
+          }
+          if (!slots_[level][(tick / span(level)) % kSlots].empty()) {
+            next = tick;
+            break;
+          }
+        }
+      }
+      return next;
+    }
+
+    // Entries of cancelled or rescheduled timers are stale
+    bool isScheduled(const Entry& entry) const {
+      auto it = timers_.find(entry.id);
+      return it != timers_.end() && it->second.expiry == entry.expiry;
+    }
+
+    void insert(UniqueId id, std::uint64_t expiry) {
+      const auto delta = expiry - current_;
+
+      std::size_t level = 0;
+      while (level < kLevels - 1 && delta >= span(level + 1)) {
+        ++level;
+      }
+
+      // Beyond the last level, wait in its furthest slot and cascade again from there
+      auto slotTick = expiry;
+      if (delta >= span(kLevels)) {
+        slotTick = current_ + span(kLevels) - 1;
+      }
+      slots_[level][(slotTick / span(level)) % kSlots].push_back({id, expiry});
+    }
+
+    void cascade(std::size_t level) {
+      auto& slot = slots_[level][(current_ / span(level)) % kSlots];
+      auto entries = std::move(slot);
+      slot.clear();
+      for (const auto& entry : entries) {
+        if (isScheduled(entry)) {
+          insert(entry.id, entry.expiry);
+        }
+      }
+    }
+
+    Clock::time_point start_;
+    std::uint64_t current_ = 0;  // Last tick advanced to
+
+    std::unordered_map<UniqueId, Timer> timers_;
+    std::array<std::array<std::vector<Entry>, kSlots>, kLevels> slots_;
+  };
+
+}  // namespace deskgui
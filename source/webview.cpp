@@ -14,32 +14,194 @@
 
 using namespace deskgui;
 
+namespace {
+  // Global function posting its argument as the payload of a keyed message
+  std::string callbackScript(const std::string& key) {
+    return "window['" + key + "'] = function(payload) { const key = '" + key + "';" +
+           R"(
+                    window.webview.postMessage({
+                              key: key,
+                              payload: payload,
+                            });
+                    }
+                )";
+  }
+
+  /**
+   * Bind protocol, version 1. Calls are posted as {"b": 1, "k": key, "i": id, "p": payload}, with
+   * ids counting up from 1 per page. Settlements come back in batches, as an array of [id, value]
+   * for resolved calls and [id, error, 1] for rejected ones, passed to window.__deskgui.s().
+   */
+  constexpr int kBindProtocolVersion = 1;
+
+  // Rejection of calls that threw something other than a std::exception
+  constexpr auto kUnknownBindError = "Bound function threw an unknown exception";
+
+  constexpr auto kBindBootstrap = R"(
+    (() => {
+      if (window.__deskgui) {
+        return;
+      }
+      const pending = new Map();
+      let lastId = 0;
+      window.__deskgui = {
+        c(key, payload) {
+          return new Promise((resolve, reject) => {
+            const id = ++lastId;
+            pending.set(id, { key, resolve, reject });
+            window.webview.postMessage({ b: 1, k: key, i: id, p: payload });
+          });
+        },
+        s(settlements) {
+          for (const [id, value, failed] of settlements) {
+            const call = pending.get(id);
+            if (call) {
+              pending.delete(id);
+              failed ? call.reject(value) : call.resolve(value);
+            }
+          }
+        },
+        u(key) {
+          for (const [id, call] of pending) {
+            if (call.key === key) {
+              pending.delete(id);
+              call.reject('Function unbound');
+            }
+          }
+        },
+      };
+    })();
+  )";
+
+  // Global function returning a Promise settled by the response to its bind message. Typed
+  // functions take their arguments one by one and send them as an array.
+  std::string bindScript(const std::string& key, bool typed = false) {
+    return std::string(kBindBootstrap) + "window['" + key + "'] = "
+           + (typed ? "(...args) => window.__deskgui.c('" + key + "', args);"
+                    : "(payload) => window.__deskgui.c('" + key + "', payload);");
+  }
+
+  std::string toJsonString(const std::string& text) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.String(text.data(), static_cast<rapidjson::SizeType>(text.size()));
+    return {buffer.GetString(), buffer.GetSize()};
+  }
+}  // namespace
+
 Webview::Webview(const std::string& name, AppHandler* appHandler, void* window,
                  const WebviewOptions& options)
-    : impl_(std::make_shared<Impl>(name, appHandler, window, options)), events_(&impl_->events()) {}
+    : impl_(std::make_shared<Impl>(name, appHandler, window, options)), events_(&impl_->events()) {
+  if (appHandler) {
+    appHandler->attachEvents(*events_);
+  }
+}
 
-Webview::~Webview() = default;
+Webview::~Webview() {
+  if (auto* appHandler = impl_->application()) {
+    appHandler->detachEvents(*events_);
+  }
+}
 
-std::string Webview::getName() const { return utils::dispatch<&Impl::getName>(impl_); }
+void Webview::runBatch(const BatchOperations& operations) {
+  auto* appHandler = impl_->application();
+  if (!appHandler || appHandler->isMainThread()) {
+    return applyBatch(operations);
+  }
+  std::weak_ptr<Impl> weakImpl = impl_;
+  appHandler->dispatchOnMainThread([this, weakImpl, &operations] {
+    if (weakImpl.lock()) {
+      applyBatch(operations);
+    }
+  });
+}
+
+void Webview::postBatch(BatchOperations&& operations) {
+  auto* appHandler = impl_->application();
+  if (!appHandler || appHandler->isMainThread()) {
+    return applyBatch(operations);
+  }
+
+  // The webview holds the only lasting reference to its impl and is destroyed on the main
+  // thread, so it is still alive there as long as the impl is
+  std::weak_ptr<Impl> weakImpl = impl_;
+  // The operations may be move-only, while posted tasks are copyable
+  auto shared = std::make_shared<BatchOperations>(std::move(operations));
+  appHandler->postOnMainThread([this, weakImpl, shared] {
+    if (weakImpl.lock()) {
+      applyBatch(*shared);
+    }
+  });
+}
+
+void Webview::applyBatch(const BatchOperations& operations) {
+  impl_->beginBatch();
+  try {
+    operations(*this);
+  } catch (...) {
+    impl_->endBatch();
+    throw;
+  }
+  impl_->endBatch();
+}
+
+void Webview::Impl::requestPosition(const ViewRect& rect) {
+  if (batchDepth_ == 0) {
+    return setPosition(rect);
+  }
+  pendingPosition_ = rect;
+}
+
+void Webview::Impl::requestResize(const ViewSize& size) {
+  if (batchDepth_ == 0) {
+    return resize(size);
+  }
+  pendingSize_ = size;
+}
+
+void Webview::Impl::endBatch() {
+  if (--batchDepth_ > 0) {
+    return;
+  }
+
+  if (auto position = std::exchange(pendingPosition_, std::nullopt)) {
+    setPosition(*position);
+  }
+  if (auto size = std::exchange(pendingSize_, std::nullopt)) {
+    resize(*size);
+  }
+}
+
+// The name never changes, no need to go through the main thread
+std::string Webview::getName() const { return impl_->getName(); }
 
 void Webview::Impl::addCallback(const std::string& key, MessageCallback callback) {
-  callbacks_.try_emplace(key, callback);
+  callbacks_.try_emplace(key, [callback = std::move(callback)](
+                                  std::string_view json, [[maybe_unused]] const rapidjson::Value&) {
+    callback(std::string(json));
+  });
+}
+
+void Webview::Impl::addJsonCallback(const std::string& key, JsonCallback callback) {
+  callbacks_.try_emplace(key, [callback = std::move(callback)](
+                                  [[maybe_unused]] std::string_view json,
+                                  const rapidjson::Value& value) { callback(value); });
 }
 
 void Webview::addCallback(const std::string& key, MessageCallback callback) {
-  auto script = "window['" + key + "'] = function(payload) { const key = '" + key + "';" +
-                R"(
-                    window.webview.postMessage({
-                              key: key,
-                              payload: payload,
-                            });
-                    }
-                )";
+  auto script = callbackScript(key);
   utils::dispatch<&Impl::addCallback>(impl_, key, callback);
   injectScript(script);
   executeScript(script);
 }
 
+void Webview::addCallback(const std::string& key, JsonCallback callback) {
+  auto script = callbackScript(key);
+  utils::dispatch<&Impl::addJsonCallback>(impl_, key, callback);
+  injectScript(script);
+  executeScript(script);
+}
+
 void Webview::Impl::removeCallback(const std::string& key) { callbacks_.erase(key); }
 
 void Webview::removeCallback(const std::string& key) {
@@ -50,7 +212,124 @@ void Webview::removeCallback(const std::string& key) {
 }
 
 void Webview::Impl::bind(const std::string& key, BindCallback func) {
-  bind_functions_.try_emplace(key, func);
+  bind_functions_.try_emplace(key, BoundFunction{std::make_shared<BindCallback>(std::move(func))});
+}
+
+void Webview::Impl::bindAsync(const std::string& key, BindCallback func) {
+  bind_functions_.try_emplace(key,
+                              BoundFunction{std::make_shared<BindCallback>(std::move(func)), true});
+}
+
+void Webview::Impl::bindJson(const std::string& key, JsonBindCallback func) {
+  bind_functions_.try_emplace(
+      key, BoundFunction{nullptr, false, std::make_shared<JsonBindCallback>(std::move(func))});
+}
+
+void Webview::Impl::callBound(const BoundFunction& function, std::uint64_t requestId,
+                              const rapidjson::Value* payload, std::string_view rawPayload) {
+  // Typed functions read the parsed arguments and write their result straight to JSON
+  if (function.typed) {
+    rapidjson::StringBuffer result;
+    JsonWriter writer(result);
+    try {
+      if (!payload) {
+        throw std::invalid_argument("Expected an array of arguments");
+      }
+      (*function.typed)(*payload, writer);
+      resolveBound(requestId, std::string_view(result.GetString(), result.GetSize()));
+    } catch (const std::exception& e) {
+      rejectBound(requestId, e.what());
+    } catch (...) {
+      rejectBound(requestId, kUnknownBindError);
+    }
+    return;
+  }
+
+  if (!function.async || !appHandler_) {
+    try {
+      resolveBound(requestId, (*function.callback)(std::string(rawPayload)));
+    } catch (const std::exception& e) {
+      rejectBound(requestId, e.what());
+    } catch (...) {
+      rejectBound(requestId, kUnknownBindError);
+    }
+    return;
+  }
+
+  // The payload is copied out of the parser buffer, which is reused by the next message. The
+  // result is delivered on the main thread, where the impl is destroyed, so it is either alive
+  // for the whole delivery or not at all. A call that finds the pool full is rejected rather
+  // than run here, on the main thread.
+  auto* appHandler = appHandler_;
+  const bool submitted = appHandler->backgroundPool().submit(
+      [appHandler, weakImpl = weak_from_this(), callback = function.callback, requestId,
+       payload = std::string(rawPayload)] {
+        std::string result;
+        std::string error;
+        bool failed = false;
+        try {
+          result = (*callback)(payload);
+        } catch (const std::exception& e) {
+          error = e.what();
+          failed = true;
+        } catch (...) {
+          error = kUnknownBindError;
+          failed = true;
+        }
+
+        appHandler->postOnMainThread([weakImpl, requestId, result = std::move(result),
+                                      error = std::move(error), failed] {
+          if (auto impl = weakImpl.lock()) {
+            if (failed) {
+              impl->rejectBound(requestId, error);
+            } else {
+              impl->resolveBound(requestId, result);
+            }
+          }
+        });
+      },
+      QueueFullPolicy::kDrop);
+
+  if (!submitted) {
+    rejectBound(requestId, "Too many pending calls");
+  }
+}
+
+void Webview::Impl::resolveBound(std::uint64_t requestId, std::string_view result) {
+  // The result is a JavaScript expression, parenthesized so that a comma or a bracket in it
+  // stays inside the settlement. An empty one resolves to undefined.
+  auto& response = pending_responses_.emplace_back("[" + std::to_string(requestId));
+  if (!result.empty()) {
+    response += ",(";
+    response.append(result);
+    response += ')';
+  }
+  response += ']';
+  scheduleResponses();
+}
+
+void Webview::Impl::rejectBound(std::uint64_t requestId, const std::string& error) {
+  pending_responses_.push_back("[" + std::to_string(requestId) + "," + toJsonString(error)
+                               + ",1]");
+  scheduleResponses();
+}
+
+void Webview::Impl::scheduleResponses() {
+  if (!appHandler_) {
+    return processPendingResponses();
+  }
+  if (responsesScheduled_) {
+    return;
+  }
+
+  // Queued behind the tasks and messages already pending, so the responses they produce are
+  // sent along in the same script
+  responsesScheduled_ = true;
+  appHandler_->postOnMainThread([weakImpl = weak_from_this()] {
+    if (auto impl = weakImpl.lock()) {
+      impl->processPendingResponses();
+    }
+  });
 }
 
 void Webview::Impl::unbind(const std::string& key) {
@@ -58,55 +337,56 @@ void Webview::Impl::unbind(const std::string& key) {
 }
 
 void Webview::Impl::processPendingResponses() {
-  if (!pending_responses_.empty()) {
-    for (const auto& response : pending_responses_) {
-      executeScript(response);
-    }
-    pending_responses_.clear();
+  responsesScheduled_ = false;
+  if (pending_responses_.empty()) {
+    return;
+  }
+
+  // Each script is a round trip to the web process, so all the responses share one
+  constexpr std::string_view kPrefix = "window.__deskgui && window.__deskgui.s([";
+  constexpr std::string_view kSuffix = "]);";
+
+  std::size_t length = kPrefix.size() + kSuffix.size();
+  for (const auto& response : pending_responses_) {
+    length += response.size() + 1;
+  }
+  std::string script;
+  script.reserve(length);
+  script += kPrefix;
+  for (const auto& response : pending_responses_) {
+    script += response;
+    script += ',';
   }
+  script += kSuffix;
+  pending_responses_.clear();
+  executeScript(script);
 }
 
 void Webview::bind(const std::string& key, BindCallback func) {
-  // Create JavaScript function that returns a Promise with secure ID generation
-  auto script = "window['" + key + "'] = function(payload) { return new Promise((resolve, reject) => {" +
-                R"(
-                    function generateId() {
-                      const crypto = window.crypto || window.msCrypto;
-                      const bytes = new Uint8Array(16);
-                      crypto.getRandomValues(bytes);
-                      return Array.from(bytes)
-                        .map(n => n.toString(16).padStart(2, '0'))
-                        .join('');
-                    }
-                    const requestId = generateId();
-
-                    window.webview.postMessage({
-                              type: 'bind',
-                              key: ')" + key + R"(',
-                              payload: payload,
-                              requestId: requestId
-                            });
+  auto script = bindScript(key);
+  utils::dispatch<&Impl::bind>(impl_, key, func);
+  injectScript(script);
+  executeScript(script);
+}
 
-                    // Store the promise resolve/reject functions
-                    window._bindPromises = window._bindPromises || {};
-                    window._bindPromises[requestId] = { resolve, reject };
-                });
-                })";
+void Webview::bindAsync(const std::string& key, BindCallback func) {
+  auto script = bindScript(key);
+  utils::dispatch<&Impl::bindAsync>(impl_, key, func);
+  injectScript(script);
+  executeScript(script);
+}
 
-  utils::dispatch<&Impl::bind>(impl_, key, func);
+void Webview::bindJson(const std::string& key, JsonBindCallback func) {
+  auto script = bindScript(key, true);
+  utils::dispatch<&Impl::bindJson>(impl_, key, func);
   injectScript(script);
   executeScript(script);
 }
 
 void Webview::unbind(const std::string& key) {
-  // Create script to delete the JavaScript function and clean up any pending promises
-  auto script = "delete window['" + key + "'];" +
-                "if (window._bindPromises) { " +
-                "  for (let requestId in window._bindPromises) { " +
-                "    window._bindPromises[requestId].reject('Function unbound'); " +
-                "    delete window._bindPromises[requestId]; " +
-                "  } " +
-                "}";
+  // Only the calls to this function are rejected, the others are still running
+  auto script = "delete window['" + key + "']; window.__deskgui && window.__deskgui.u('" + key
+                + "');";
 
   utils::dispatch<&Impl::unbind>(impl_, key);
   injectScript(script);
@@ -114,79 +394,81 @@ void Webview::unbind(const std::string& key) {
 }
 
 void Webview::processPendingResponses() {
-  auto& responses = impl_->getPendingResponses();
-  if (!responses.empty()) {
-    for (const auto& response : responses) {
-      executeScript(response);
-    }
-    responses.clear();
-  }
+  utils::dispatch<&Impl::processPendingResponses>(impl_);
 }
 
 void Webview::postMessage(const std::string& message) {
   executeScript("window.webview.onMessage('" + message + "');");
 }
 
-void Webview::Impl::onMessage(const std::string& message) {
-  rapidjson::Document doc;
-  doc.Parse(message.c_str());
-  if (!doc.HasParseError() && doc.IsObject()) {
-    // Handle bind type messages (for functions that return values)
-    if (doc.HasMember("type") && doc["type"].IsString() && std::string(doc["type"].GetString()) == "bind") {
-      if (doc.HasMember("key") && doc.HasMember("requestId")) {
-        const auto& key = doc["key"];
-        const auto& requestId = doc["requestId"];
-        if (key.IsString() && requestId.IsString()) {
-          std::string keyStr = key.GetString();
-          std::string requestIdStr = requestId.GetString();
-
-          auto bind_func = bind_functions_.find(keyStr);
-          if (bind_func != bind_functions_.end()) {
-            std::string payload;
-            if (doc.HasMember("payload")) {
-              const auto& payloadVal = doc["payload"];
-              rapidjson::StringBuffer buffer;
-              rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-              payloadVal.Accept(writer);
-              payload = buffer.GetString();
-            }
-
-            try {
-              std::string result = bind_func->second(payload);
-              // Send the result back to JavaScript
-              std::string responseScript = "if (window._bindPromises && window._bindPromises['" + requestIdStr + "']) { window._bindPromises['" + requestIdStr + "'].resolve(" + result + "); delete window._bindPromises['" + requestIdStr + "']; }";
-              pending_responses_.push_back(responseScript);
+void Webview::Impl::onMessage(std::string_view message) {
+  // A message delivered while a handler runs, for instance from a modal loop, can't reuse the
+  // parser whose values the handler is still reading
+  std::unique_ptr<MessageParser> nestedParser;
+  auto* parser = &parser_;
+  if (messageDepth_ > 0) {
+    nestedParser = std::make_unique<MessageParser>();
+    parser = nestedParser.get();
+  }
 
-              // Process responses immediately to ensure they reach JavaScript
-              processPendingResponses();
-            } catch (const std::exception& e) {
-              std::string errorScript = "if (window._bindPromises && window._bindPromises['" + requestIdStr + "']) { window._bindPromises['" + requestIdStr + "'].reject('" + std::string(e.what()) + "'); delete window._bindPromises['" + requestIdStr + "']; }";
-              pending_responses_.push_back(errorScript);
+  ++messageDepth_;
+  try {
+    handleMessage(*parser, message);
+  } catch (...) {
+    --messageDepth_;
+    throw;
+  }
+  --messageDepth_;
+}
 
-              // Process error responses immediately
-              processPendingResponses();
-            }
-          }
-        }
+void Webview::Impl::handleMessage(MessageParser& parser, std::string_view message) {
+  // Keyed listeners are looked up with the key parsed here instead of re-parsing the message
+  std::string_view messageKey;
+  if (parser.parse(message)) {
+    messageKey = parser.string("key");
+
+    // Handle bind calls (for functions that return values)
+    if (const auto* version = parser.value("b");
+        version && version->IsInt() && version->GetInt() == kBindProtocolVersion) {
+      // Bind keys name functions, not message channels: the call only reaches unkeyed listeners
+      messageKey = {};
+      const auto* requestId = parser.value("i");
+      auto bind_func = bind_functions_.find(std::string(parser.string("k")));
+      if (requestId && requestId->IsUint64() && bind_func != bind_functions_.end()) {
+        callBound(bind_func->second, requestId->GetUint64(), parser.value("p"), parser.raw("p"));
       }
     }
-    // Handle regular callback messages
-    else if (doc.HasMember("key") && doc.HasMember("payload")) {
-      const auto& key = doc["key"];
-      if (key.IsString()) {
-        std::string keyStr = key.GetString();
-        auto callback = callbacks_.find(keyStr);
-        if (callback != callbacks_.end()) {
-          const auto& payload = doc["payload"];
-          rapidjson::StringBuffer buffer;
-          rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-          payload.Accept(writer);
-          callback->second(buffer.GetString());
-        }
+    // Handle regular callback messages, with the payload text sliced out of the message
+    else if (const auto* payload = parser.value("payload"); payload && !messageKey.empty()) {
+      if (auto callback = callbacks_.find(std::string(messageKey)); callback != callbacks_.end()) {
+        callback->second(parser.raw("payload"), *payload);
       }
     }
   }
-  events().emit(deskgui::event::WebviewOnMessage{message});
+  events().emit(event::WebviewOnMessageView{message}, messageKey);
+  events().emitLazy<event::WebviewOnMessage>(
+      [message] { return event::WebviewOnMessage{std::string(message)}; }, messageKey);
+}
+
+bool Webview::Impl::onNavigationStarting(std::string_view url) {
+  event::WebviewNavigationStartingView view{url};
+  events().emit(view);
+  if (view.isCancelled()) {
+    return true;
+  }
+
+  if (!events().hasListeners<event::WebviewNavigationStarting>()) {
+    return false;
+  }
+  event::WebviewNavigationStarting event{std::string(url)};
+  events().emit(event);
+  return event.isCancelled();
+}
+
+void Webview::Impl::onSourceChanged(std::string_view source) {
+  events().emit(event::WebviewSourceChangedView{source});
+  events().emitLazy<event::WebviewSourceChanged>(
+      [source] { return event::WebviewSourceChanged{std::string(source)}; });
 }
 
 // Settings methods
@@ -204,12 +486,14 @@ void Webview::enableAcceleratorKeys(bool state) {
 
 // View methods
 void Webview::setPosition(const ViewRect& rect) {
-  utils::dispatch<&Impl::setPosition>(impl_, rect);
+  utils::dispatch<&Impl::requestPosition>(impl_, rect);
 }
 
 void Webview::show(bool state) { utils::dispatch<&Impl::show>(impl_, state); }
 
-void Webview::resize(const ViewSize& size) { utils::dispatch<&Impl::resize>(impl_, size); }
+void Webview::resize(const ViewSize& size) {
+  utils::dispatch<&Impl::requestResize>(impl_, size);
+}
 
 // Content methods
 void Webview::navigate(const std::string& url) { utils::dispatch<&Impl::navigate>(impl_, url); }
@@ -232,6 +516,12 @@ void Webview::clearResources() { utils::dispatch<&Impl::clearResources>(impl_);
 
 std::string Webview::getUrl() { return utils::dispatch<&Impl::getUrl>(impl_); }
 
+ResultAwaiter<std::string> Webview::getUrlAsync() {
+  return ResultAwaiter<std::string>([this](ResultAwaiter<std::string>::Callback callback) {
+    utils::post<&Impl::resolveUrl>(impl_, std::move(callback));
+  });
+}
+
 // Functionality methods
 void Webview::injectScript(const std::string& script) {
   utils::dispatch<&Impl::injectScript>(impl_, script);
@@ -239,4 +529,14 @@ void Webview::injectScript(const std::string& script) {
 
 void Webview::executeScript(const std::string& script) {
   utils::dispatch<&Impl::executeScript>(impl_, script);
+}
+
+void Webview::evaluateScript(const std::string& script, ScriptCallback callback) {
+  utils::dispatch<&Impl::evaluateScript>(impl_, script, std::move(callback));
+}
+
+ResultAwaiter<std::string> Webview::evaluateScriptAsync(const std::string& script) {
+  return ResultAwaiter<std::string>([this, script](ResultAwaiter<std::string>::Callback callback) {
+    evaluateScript(script, std::move(callback));
+  });
 }
\ No newline at end of file
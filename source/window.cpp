@@ -33,6 +33,140 @@ Webview* Window::Impl::getWebview(const std::string& name) const {
   }
 }
 
+void Window::Impl::applyTitle(const std::string& title) {
+  setTitle(title);
+  cacheTitle(title);
+}
+
+void Window::Impl::applyResizable(bool resizable) {
+  setResizable(resizable);
+  cacheResizable(resizable);
+}
+
+void Window::Impl::applyDecorations(bool decorations) {
+  setDecorations(decorations);
+  cacheDecorations(decorations);
+}
+
+void Window::Impl::refreshState() {
+  cacheTitle(getTitle());
+  cacheResizable(isResizable());
+  cacheDecorations(isDecorated());
+  cacheScaleFactor(monitorScaleFactor_);
+  refreshGeometry();
+}
+
+void Window::Impl::refreshGeometry() {
+  cacheGeometry(getSize(PixelsType::kPhysical), getPosition(PixelsType::kPhysical));
+}
+
+void Window::Impl::cacheGeometry(const ViewSize& size, const ViewRect& position) {
+  std::lock_guard lock(cachedGeometryMutex_);
+  cachedSize_ = size;
+  cachedPosition_ = position;
+}
+
+ViewSize Window::Impl::cachedSize(PixelsType type) const {
+  std::unique_lock lock(cachedGeometryMutex_);
+  auto size = cachedSize_;
+  lock.unlock();
+
+  if (type == PixelsType::kLogical) {
+    const auto scaleFactor = cachedScaleFactor();
+    size.first /= scaleFactor;
+    size.second /= scaleFactor;
+  }
+  return size;
+}
+
+ViewRect Window::Impl::cachedPosition(PixelsType type) const {
+  std::unique_lock lock(cachedGeometryMutex_);
+  auto position = cachedPosition_;
+  lock.unlock();
+
+  if (type == PixelsType::kLogical) {
+    const auto scaleFactor = cachedScaleFactor();
+    position.L /= scaleFactor;
+    position.T /= scaleFactor;
+    position.R /= scaleFactor;
+    position.B /= scaleFactor;
+  }
+  return position;
+}
+
+void Window::Impl::cacheTitle(const std::string& title) {
+  std::lock_guard lock(cachedTitleMutex_);
+  cachedTitle_ = title;
+}
+
+std::string Window::Impl::cachedTitle() const {
+  std::lock_guard lock(cachedTitleMutex_);
+  return cachedTitle_;
+}
+
+void Window::Impl::requestSize(const ViewSize& size, PixelsType type) {
+  if (batchDepth_ == 0) {
+    return setSize(size, type);
+  }
+  pendingGeometry_.size = {size, type};
+}
+
+void Window::Impl::requestMaxSize(const ViewSize& size, PixelsType type) {
+  if (batchDepth_ == 0) {
+    return setMaxSize(size, type);
+  }
+  pendingGeometry_.maxSize = {size, type};
+}
+
+void Window::Impl::requestMinSize(const ViewSize& size, PixelsType type) {
+  if (batchDepth_ == 0) {
+    return setMinSize(size, type);
+  }
+  pendingGeometry_.minSize = {size, type};
+}
+
+void Window::Impl::requestPosition(const ViewRect& position, PixelsType type) {
+  if (batchDepth_ == 0) {
+    return setPosition(position, type);
+  }
+  // The position also sets the size and overrides an earlier center
+  pendingGeometry_.position = {position, type};
+  pendingGeometry_.size.reset();
+  pendingGeometry_.center = false;
+}
+
+void Window::Impl::requestCenter() {
+  if (batchDepth_ == 0) {
+    return center();
+  }
+  pendingGeometry_.center = true;
+}
+
+void Window::Impl::endBatch() {
+  if (--batchDepth_ > 0) {
+    return;
+  }
+
+  // Size limits first, so that the size and position are clamped to the new ones. A size
+  // requested after the position overrides its size, and centering uses the final size.
+  auto geometry = std::exchange(pendingGeometry_, PendingGeometry{});
+  if (geometry.maxSize) {
+    setMaxSize(geometry.maxSize->first, geometry.maxSize->second);
+  }
+  if (geometry.minSize) {
+    setMinSize(geometry.minSize->first, geometry.minSize->second);
+  }
+  if (geometry.position) {
+    setPosition(geometry.position->first, geometry.position->second);
+  }
+  if (geometry.size) {
+    setSize(geometry.size->first, geometry.size->second);
+  }
+  if (geometry.center) {
+    center();
+  }
+}
+
 Webview* Window::createWebview(const std::string& name, const WebviewOptions& options) {
   return utils::dispatch<&Impl::createWebview>(impl_, name, options);
 }
@@ -46,28 +180,91 @@ Webview* Window::getWebview(const std::string& name) const {
 }
 
 Window::Window(const std::string& name, AppHandler* appHandler, void* nativeWindow)
-    : impl_(std::make_shared<Impl>(name, appHandler, nativeWindow)), events_(&impl_->events()) {}
+    : impl_(std::make_shared<Impl>(name, appHandler, nativeWindow)), events_(&impl_->events()) {
+  impl_->refreshState();
+  if (appHandler) {
+    appHandler->attachEvents(*events_);
+  }
+}
 
-Window::~Window() = default;
+Window::~Window() {
+  if (auto* appHandler = impl_->application()) {
+    appHandler->detachEvents(*events_);
+  }
+}
 
-std::string Window::getName() const { return utils::dispatch<&Impl::getName>(impl_); }
+void Window::runBatch(const BatchOperations& operations) {
+  auto* appHandler = impl_->application();
+  if (!appHandler || appHandler->isMainThread()) {
+    return applyBatch(operations);
+  }
+  std::weak_ptr<Impl> weakImpl = impl_;
+  appHandler->dispatchOnMainThread([this, weakImpl, &operations] {
+    if (weakImpl.lock()) {
+      applyBatch(operations);
+    }
+  });
+}
+
+void Window::postBatch(BatchOperations&& operations) {
+  auto* appHandler = impl_->application();
+  if (!appHandler || appHandler->isMainThread()) {
+    return applyBatch(operations);
+  }
+
+  // The window holds the only lasting reference to its impl and is destroyed on the main thread,
+  // so it is still alive there as long as the impl is
+  std::weak_ptr<Impl> weakImpl = impl_;
+  // The operations may be move-only, while posted tasks are copyable
+  auto shared = std::make_shared<BatchOperations>(std::move(operations));
+  appHandler->postOnMainThread([this, weakImpl, shared] {
+    if (weakImpl.lock()) {
+      applyBatch(*shared);
+    }
+  });
+}
+
+void Window::applyBatch(const BatchOperations& operations) {
+  impl_->beginBatch();
+  try {
+    operations(*this);
+  } catch (...) {
+    impl_->endBatch();
+    throw;
+  }
+  impl_->endBatch();
+}
+
+// The name never changes, no need to go through the main thread
+std::string Window::getName() const { return impl_->getName(); }
 
 // Title methods
-void Window::setTitle(const std::string& title) { utils::dispatch<&Impl::setTitle>(impl_, title); }
+void Window::setTitle(const std::string& title) {
+  impl_->cacheTitle(title);
+  utils::dispatch<&Impl::applyTitle>(impl_, title);
+}
 
-std::string Window::getTitle() const { return utils::dispatch<&Impl::getTitle>(impl_); }
+std::string Window::getTitle(ReadMode mode) const {
+  if (mode == ReadMode::kCached) {
+    return impl_->cachedTitle();
+  }
+  return utils::dispatch<&Impl::getTitle>(impl_);
+}
 
 // Size methods
 void Window::setSize(const ViewSize& size, PixelsType type) {
-  utils::dispatch<&Impl::setSize>(impl_, size, type);
+  utils::dispatch<&Impl::requestSize>(impl_, size, type);
 }
 
-ViewSize Window::getSize(PixelsType type) const {
+ViewSize Window::getSize(PixelsType type, ReadMode mode) const {
+  if (mode == ReadMode::kCached) {
+    return impl_->cachedSize(type);
+  }
   return utils::dispatch<&Impl::getSize>(impl_, type);
 }
 
 void Window::setMaxSize(const ViewSize& size, PixelsType type) {
-  utils::dispatch<&Impl::setMaxSize>(impl_, size, type);
+  utils::dispatch<&Impl::requestMaxSize>(impl_, size, type);
 }
 
 ViewSize Window::getMaxSize(PixelsType type) const {
@@ -75,7 +272,7 @@ ViewSize Window::getMaxSize(PixelsType type) const {
 }
 
 void Window::setMinSize(const ViewSize& size, PixelsType type) {
-  utils::dispatch<&Impl::setMinSize>(impl_, size, type);
+  utils::dispatch<&Impl::requestMinSize>(impl_, size, type);
 }
 
 ViewSize Window::getMinSize(PixelsType type) const {
@@ -84,32 +281,47 @@ ViewSize Window::getMinSize(PixelsType type) const {
 
 // Position methods
 void Window::setPosition(const ViewRect& position, PixelsType type) {
-  utils::dispatch<&Impl::setPosition>(impl_, position, type);
+  utils::dispatch<&Impl::requestPosition>(impl_, position, type);
 }
 
-ViewRect Window::getPosition(PixelsType type) const {
+ViewRect Window::getPosition(PixelsType type, ReadMode mode) const {
+  if (mode == ReadMode::kCached) {
+    return impl_->cachedPosition(type);
+  }
   return utils::dispatch<&Impl::getPosition>(impl_, type);
 }
 
 // Behavior methods
 void Window::setResizable(bool resizable) {
-  utils::dispatch<&Impl::setResizable>(impl_, resizable);
+  impl_->cacheResizable(resizable);
+  utils::dispatch<&Impl::applyResizable>(impl_, resizable);
 }
 
-bool Window::isResizable() const { return utils::dispatch<&Impl::isResizable>(impl_); }
+bool Window::isResizable(ReadMode mode) const {
+  if (mode == ReadMode::kCached) {
+    return impl_->cachedResizable();
+  }
+  return utils::dispatch<&Impl::isResizable>(impl_);
+}
 
 void Window::setDecorations(bool decorations) {
-  utils::dispatch<&Impl::setDecorations>(impl_, decorations);
+  impl_->cacheDecorations(decorations);
+  utils::dispatch<&Impl::applyDecorations>(impl_, decorations);
 }
 
-bool Window::isDecorated() const { return utils::dispatch<&Impl::isDecorated>(impl_); }
+bool Window::isDecorated(ReadMode mode) const {
+  if (mode == ReadMode::kCached) {
+    return impl_->cachedDecorated();
+  }
+  return utils::dispatch<&Impl::isDecorated>(impl_);
+}
 
 // Visibility methods
 void Window::hide() { utils::dispatch<&Impl::hide>(impl_); }
 
 void Window::show() { utils::dispatch<&Impl::show>(impl_); }
 
-void Window::center() { utils::dispatch<&Impl::center>(impl_); }
+void Window::center() { utils::dispatch<&Impl::requestCenter>(impl_); }
 
 void Window::enable(bool state) { utils::dispatch<&Impl::enable>(impl_, state); }
 
@@ -127,9 +339,13 @@ void* Window::getContentView() const { return utils::dispatch<&Impl::getContentV
 
 // Monitor scale factor methods
 void Window::setMonitorScaleFactor(float scaleFactor) {
+  impl_->cacheScaleFactor(scaleFactor);
   utils::dispatch<&Impl::setMonitorScaleFactor>(impl_, scaleFactor);
 }
 
-float Window::getMonitorScaleFactor() const {
+float Window::getMonitorScaleFactor(ReadMode mode) const {
+  if (mode == ReadMode::kCached) {
+    return impl_->cachedScaleFactor();
+  }
   return utils::dispatch<&Impl::getMonitorScaleFactor>(impl_);
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include <deskgui/app.h>
+
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("App timers") {
+  deskgui::App app;
+
+  SECTION("Timeouts fire in expiry order, never early") {
+    std::vector<int> order;
+    const auto start = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::steady_clock::duration::zero();
+
+    app.setTimeout([&] { order.push_back(2); }, 20ms);
+    app.setTimeout([&] { order.push_back(1); }, 10ms);
+    app.setTimeout(
+        [&] {
+          elapsed = std::chrono::steady_clock::now() - start;
+          app.terminate();
+        },
+        30ms);
+    app.run();
+
+    CHECK(order == std::vector<int>{1, 2});
+    CHECK(elapsed >= 30ms);
+  }
+
+  SECTION("Cancelled timers do not fire") {
+    bool fired = false;
+    const auto id = app.setTimeout([&] { fired = true; }, 10ms);
+    app.setTimeout([&] { app.terminate(); }, 20ms);
+    app.cancel(id);
+    app.run();
+
+    CHECK_FALSE(fired);
+  }
+
+  SECTION("Intervals repeat until cancelled") {
+    int count = 0;
+    deskgui::UniqueId id = 0;
+    id = app.setInterval(
+        [&] {
+          if (++count == 3) {
+            app.cancel(id);
+            app.terminate();
+          }
+        },
+        5ms);
+    app.run();
+
+    CHECK(count == 3);
+  }
+
+  SECTION("Intervals must be positive") {
+    CHECK_THROWS_AS(app.setInterval([] {}, 0ms), std::invalid_argument);
+    CHECK_THROWS_AS(app.setInterval([] {}, -5ms), std::invalid_argument);
+  }
+}
+
+TEST_CASE("App background work") {
+  deskgui::App app("deskgui", 1);  // A single worker runs the work in order
+
+  SECTION("Continuations receive the result on the main thread") {
+    std::thread::id workerThread;
+    std::string result;
+    bool onMainThread = false;
+
+    app.runInBackground([&] {
+         workerThread = std::this_thread::get_id();
+         return std::string("done");
+       })
+        .then([&](std::string value) {
+          result = std::move(value);
+          onMainThread = app.isMainThread();
+          app.terminate();
+        });
+    app.run();
+
+    CHECK(result == "done");
+    CHECK(onMainThread);
+    CHECK(workerThread != std::this_thread::get_id());
+  }
+
+  SECTION("Work without continuation still runs") {
+    std::atomic<bool> ran = false;
+    app.runInBackground([&] { ran = true; });
+    app.runInBackground([] {}).then([&] { app.terminate(); });
+    app.run();
+
+    CHECK(ran);
+  }
+
+  SECTION("Move-only work and errors delivered on the main thread") {
+    bool onMainThread = false;
+    std::string message;
+
+    app.runInBackground([value = std::make_unique<int>(1)]() -> int {
+         throw std::runtime_error("failed " + std::to_string(*value));
+       })
+        .then([&]([[maybe_unused]] int value) { app.terminate(); },
+              [&](std::exception_ptr error) {
+                onMainThread = app.isMainThread();
+                try {
+                  std::rethrow_exception(error);
+                } catch (const std::runtime_error& e) {
+                  message = e.what();
+                }
+                app.terminate();
+              });
+    app.run();
+
+    CHECK(message == "failed 1");
+    CHECK(onMainThread);
+  }
+}
+
+TEST_CASE("App driven by an external loop") {
+  deskgui::App app;
+
+  SECTION("Polling runs timers and posted tasks") {
+    bool timerFired = false;
+    bool taskRan = false;
+    app.setTimeout([&] { timerFired = true; }, 10ms);
+    std::thread([&] { app.postOnMainThread([&] { taskRan = true; }); }).join();
+
+    const auto deadline = std::chrono::steady_clock::now() + 1s;
+    while (!(timerFired && taskRan) && std::chrono::steady_clock::now() < deadline) {
+      const auto info = app.getPollInfo();
+      app.poll(info.timeout.value_or(10ms));
+    }
+
+    CHECK(app.isMainThread());
+    CHECK(timerFired);
+    CHECK(taskRan);
+  }
+
+  SECTION("Stepping stops once terminated") {
+    app.step();
+    app.terminate();
+
+    CHECK_FALSE(app.isRunning());
+    CHECK_FALSE(app.step());
+  }
+}
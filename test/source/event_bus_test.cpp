@@ -0,0 +1,463 @@
+#include <deskgui/event_bus.h>
+
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+  struct OrderEvent {
+    std::vector<int>* calls;
+  };
+
+  struct ReentrantEvent {
+    std::vector<int>* calls;
+  };
+
+  struct SlotEvent {
+    std::vector<int>* calls;
+  };
+
+  struct OtherSlotEvent {
+    std::vector<int>* calls;
+  };
+
+  struct FreshSlotEvent {
+    std::vector<int>* calls;
+  };
+
+  template <std::size_t> struct UnconnectedEvent {};
+
+  template <std::size_t... Indexes>
+  void useUnconnected(deskgui::EventBus& bus, std::index_sequence<Indexes...>) {
+    (bus.emit(UnconnectedEvent<Indexes>{}), ...);
+    ((void)bus.count<UnconnectedEvent<Indexes>>(), ...);
+    (bus.post<UnconnectedEvent<Indexes>>(), ...);
+  }
+
+  struct CallableEvent {
+    std::vector<int>* calls;
+  };
+
+  struct LazyEvent {
+    int value;
+  };
+
+  struct KeyedEvent {
+    std::vector<std::string>* calls;
+  };
+
+  struct PriorityEvent {
+    std::vector<int>* calls;
+  };
+
+  struct ChurnEvent {
+    std::map<int, int>* calls;
+  };
+
+  struct StoppableEvent : deskgui::event::Event {
+    StoppableEvent() : Event(true) {}
+    std::vector<int> calls;
+  };
+
+  struct QueuedEvent {
+    int value;
+  };
+
+  struct CountedEvent {
+    explicit CountedEvent(std::size_t posts) : count(posts) {}
+    std::size_t count;
+  };
+
+  struct AsyncEvent {
+    int value;
+  };
+}  // namespace
+
+template <> struct deskgui::EventStopsOnCancel<StoppableEvent> : std::true_type {};
+
+template <> struct deskgui::EventPostPolicy<CountedEvent> {
+  static constexpr PostPolicy value = PostPolicy::kCountOnly;
+};
+
+TEST_CASE("EventBus snapshots") {
+  deskgui::EventBus bus;
+
+  SECTION("Listeners connected during an emit receive the next one") {
+    std::vector<int> calls;
+    bool connected = false;
+    bus.connect<ReentrantEvent>([&bus, &connected](ReentrantEvent& event) {
+      event.calls->push_back(1);
+      if (!connected) {
+        connected = true;
+        bus.connect<ReentrantEvent>([](ReentrantEvent& event) { event.calls->push_back(2); });
+      }
+    });
+
+    bus.emit(ReentrantEvent{&calls});
+    CHECK(calls == std::vector<int>{1});
+
+    calls.clear();
+    bus.emit(ReentrantEvent{&calls});
+    CHECK(calls == std::vector<int>{1, 2});
+  }
+
+  SECTION("Listeners may disconnect themselves during an emit") {
+    std::vector<int> calls;
+    deskgui::UniqueId id = 0;
+    id = bus.connect<ReentrantEvent>([&bus, &id](ReentrantEvent& event) {
+      event.calls->push_back(1);
+      bus.disconnect<ReentrantEvent>(id);
+    });
+    bus.connect<ReentrantEvent>([](ReentrantEvent& event) { event.calls->push_back(2); });
+
+    bus.emit(ReentrantEvent{&calls});
+    CHECK(calls == std::vector<int>{1, 2});
+
+    calls.clear();
+    bus.emit(ReentrantEvent{&calls});
+    CHECK(calls == std::vector<int>{2});
+    CHECK(bus.count<ReentrantEvent>() == 1);
+  }
+}
+
+TEST_CASE("EventBus slots") {
+  deskgui::EventBus bus;
+
+  SECTION("Each event type has its own listeners") {
+    std::vector<int> calls;
+    bus.connect<SlotEvent>([](SlotEvent& event) { event.calls->push_back(1); });
+    bus.connect<OtherSlotEvent>([](OtherSlotEvent& event) { event.calls->push_back(2); });
+
+    bus.emit(SlotEvent{&calls});
+    CHECK(calls == std::vector<int>{1});
+    CHECK(bus.count<SlotEvent>() == 1);
+    CHECK(bus.count<OtherSlotEvent>() == 1);
+  }
+
+  SECTION("Lvalue and rvalue events share the slot of their type") {
+    std::vector<int> calls;
+    bus.connect<SlotEvent>([](const SlotEvent& event) { event.calls->push_back(1); });
+
+    SlotEvent event{&calls};
+    bus.emit(event);
+    bus.emit(SlotEvent{&calls});
+    CHECK(calls == std::vector<int>{1, 1});
+    CHECK(bus.count<const SlotEvent>() == 1);
+  }
+
+  SECTION("Types that are never connected don't take a slot") {
+    useUnconnected(bus, std::make_index_sequence<2 * deskgui::EventBus::kMaxEventTypes>{});
+    CHECK_FALSE(bus.hasPosted());
+
+    std::vector<int> calls;
+    bus.connect<FreshSlotEvent>([](FreshSlotEvent& event) { event.calls->push_back(1); });
+    bus.emit(FreshSlotEvent{&calls});
+    CHECK(calls == std::vector<int>{1});
+  }
+}
+
+TEST_CASE("EventBus listener storage") {
+  deskgui::EventBus bus;
+
+  SECTION("Move-only listeners") {
+    std::vector<int> calls;
+    bus.connect<CallableEvent>([value = std::make_unique<int>(7)](CallableEvent& event) {
+      event.calls->push_back(*value);
+    });
+
+    bus.emit(CallableEvent{&calls});
+    CHECK(calls == std::vector<int>{7});
+  }
+
+  SECTION("Listeners larger than the inline capacity") {
+    std::array<int, deskgui::EventBus::kListenerCapacity> values{};
+    values.back() = 3;
+    static_assert(sizeof(values) > deskgui::EventBus::kListenerCapacity);
+
+    std::vector<int> calls;
+    bus.connect<CallableEvent>(
+        [values](CallableEvent& event) { event.calls->push_back(values.back()); });
+    bus.connect<CallableEvent>([](CallableEvent& event) { event.calls->push_back(4); });
+
+    bus.emit(CallableEvent{&calls});
+    CHECK(calls == std::vector<int>{3, 4});
+  }
+}
+
+TEST_CASE("EventBus lazy emit") {
+  deskgui::EventBus bus;
+
+  SECTION("Events nobody listens to are not built") {
+    int built = 0;
+    CHECK_FALSE(bus.hasListeners<LazyEvent>());
+    bus.emitLazy<LazyEvent>([&built] { return LazyEvent{++built}; });
+    CHECK(built == 0);
+  }
+
+  SECTION("Events are built once for all their listeners") {
+    int built = 0;
+    std::vector<int> values;
+    bus.connect<LazyEvent>([&values](LazyEvent& event) { values.push_back(event.value); });
+    bus.connect<LazyEvent>([&values](LazyEvent& event) { values.push_back(event.value); });
+
+    CHECK(bus.hasListeners<LazyEvent>());
+    bus.emitLazy<LazyEvent>([&built] { return LazyEvent{++built}; });
+    CHECK(built == 1);
+    CHECK(values == std::vector<int>{1, 1});
+  }
+}
+
+TEST_CASE("EventBus connections") {
+  deskgui::EventBus bus;
+
+  SECTION("Listeners are invoked in connect order across blocks and compactions") {
+    constexpr int kNumOfListeners = 3 * static_cast<int>(deskgui::EventBus::kBlockSize) + 5;
+
+    std::vector<deskgui::UniqueId> ids;
+    for (int listener = 0; listener < kNumOfListeners; ++listener) {
+      ids.push_back(bus.connect<OrderEvent>(
+          [listener](OrderEvent& event) { event.calls->push_back(listener); }));
+    }
+
+    // Disconnecting most of them compacts the listeners
+    std::vector<int> expected;
+    for (int listener = 0; listener < kNumOfListeners; ++listener) {
+      if (listener % 4 == 0) {
+        expected.push_back(listener);
+      } else {
+        bus.disconnect<OrderEvent>(ids[static_cast<std::size_t>(listener)]);
+      }
+    }
+
+    std::vector<int> calls;
+    bus.emit(OrderEvent{&calls});
+    CHECK(calls == expected);
+    CHECK(bus.count<OrderEvent>() == expected.size());
+
+    // New listeners go after the remaining ones
+    bus.connect<OrderEvent>([](OrderEvent& event) { event.calls->push_back(-1); });
+    expected.push_back(-1);
+    calls.clear();
+    bus.emit(OrderEvent{&calls});
+    CHECK(calls == expected);
+  }
+
+  SECTION("Stale ids don't disconnect the listener that reused their handle") {
+    std::vector<int> calls;
+    const auto first
+        = bus.connect<OrderEvent>([](OrderEvent& event) { event.calls->push_back(1); });
+    bus.disconnect<OrderEvent>(first);
+    bus.connect<OrderEvent>([](OrderEvent& event) { event.calls->push_back(2); });
+
+    bus.disconnect<OrderEvent>(first);
+    bus.emit(OrderEvent{&calls});
+    CHECK(calls == std::vector<int>{2});
+  }
+
+  SECTION("Keyed listeners only receive the events emitted with their key") {
+    std::vector<std::string> calls;
+    bus.connect<KeyedEvent>([](KeyedEvent& event) { event.calls->push_back("any"); });
+    bus.connect<KeyedEvent>("a", [](KeyedEvent& event) { event.calls->push_back("a"); });
+    bus.connect<KeyedEvent>("b", [](KeyedEvent& event) { event.calls->push_back("b"); });
+
+    bus.emit(KeyedEvent{&calls}, "a");
+    CHECK(calls == std::vector<std::string>{"any", "a"});
+
+    calls.clear();
+    bus.emit(KeyedEvent{&calls});
+    CHECK(calls == std::vector<std::string>{"any"});
+
+    calls.clear();
+    bus.emit(KeyedEvent{&calls}, "c");
+    CHECK(calls == std::vector<std::string>{"any"});
+  }
+}
+
+TEST_CASE("EventBus priorities") {
+  deskgui::EventBus bus;
+
+  SECTION("Higher priorities first, then connect order") {
+    std::vector<int> calls;
+    bus.connect<PriorityEvent>([](PriorityEvent& event) { event.calls->push_back(1); });
+    bus.connect<PriorityEvent>([](PriorityEvent& event) { event.calls->push_back(2); }, 2);
+    bus.connect<PriorityEvent>([](PriorityEvent& event) { event.calls->push_back(3); }, 1);
+    bus.connect<PriorityEvent>([](PriorityEvent& event) { event.calls->push_back(4); }, 2);
+
+    bus.emit(PriorityEvent{&calls});
+    CHECK(calls == std::vector<int>{2, 4, 3, 1});
+  }
+
+  SECTION("Cancelling stops the delivery of events that opt in") {
+    bus.connect<StoppableEvent>([](StoppableEvent& event) { event.calls.push_back(1); });
+    bus.connect<StoppableEvent>(
+        [](StoppableEvent& event) {
+          event.calls.push_back(2);
+          event.preventDefault();
+        },
+        1);
+
+    StoppableEvent event;
+    bus.emit(event);
+    CHECK(event.calls == std::vector<int>{2});
+    CHECK(event.isCancelled());
+  }
+
+  SECTION("Vetoing a window close stops the delivery") {
+    std::vector<int> calls;
+    bus.connect<deskgui::event::WindowClose>(
+        [&calls]([[maybe_unused]] deskgui::event::WindowClose& event) { calls.push_back(1); });
+    bus.connect<deskgui::event::WindowClose>(
+        [&calls](deskgui::event::WindowClose& event) {
+          calls.push_back(2);
+          event.preventDefault();
+        },
+        1);
+
+    deskgui::event::WindowClose event;
+    bus.emit(event);
+    CHECK(calls == std::vector<int>{2});
+    CHECK(event.isCancelled());
+  }
+
+  SECTION("Cancelling events that don't opt in reaches every listener") {
+    std::vector<int> calls;
+    bus.connect<deskgui::event::WindowResize>(
+        [&calls](deskgui::event::WindowResize& event) {
+          calls.push_back(1);
+          event.preventDefault();
+        },
+        1);
+    bus.connect<deskgui::event::WindowResize>(
+        [&calls]([[maybe_unused]] deskgui::event::WindowResize& event) { calls.push_back(2); });
+
+    deskgui::event::WindowResize event{deskgui::ViewSize{}};
+    bus.emit(event);
+    CHECK(calls == std::vector<int>{1, 2});
+  }
+
+  SECTION("Disconnecting after a priority insert that reused a handle") {
+    std::vector<int> calls;
+    bus.connect<PriorityEvent>([](PriorityEvent& event) { event.calls->push_back(1); });
+    const auto second
+        = bus.connect<PriorityEvent>([](PriorityEvent& event) { event.calls->push_back(2); });
+    bus.disconnect<PriorityEvent>(second);
+
+    // Takes the handle of the disconnected listener, ahead of its entry
+    const auto third = bus.connect<PriorityEvent>(
+        [](PriorityEvent& event) { event.calls->push_back(3); }, 1);
+    bus.disconnect<PriorityEvent>(third);
+
+    bus.emit(PriorityEvent{&calls});
+    CHECK(calls == std::vector<int>{1});
+    CHECK(bus.count<PriorityEvent>() == 1);
+  }
+
+  SECTION("Random connects and disconnects match the connected listeners") {
+    std::mt19937 random(42);
+    std::map<int, deskgui::UniqueId> connected;  // Listener number to id
+    int nextListener = 0;
+
+    for (int round = 0; round < 2000; ++round) {
+      if (connected.empty() || random() % 3 != 0) {
+        const auto listener = nextListener++;
+        const auto priority = static_cast<int>(random() % 4);
+        connected[listener] = bus.connect<ChurnEvent>(
+            [listener](ChurnEvent& event) { ++(*event.calls)[listener]; }, priority);
+      } else {
+        auto it = std::next(connected.begin(),
+                            static_cast<std::ptrdiff_t>(random() % connected.size()));
+        bus.disconnect<ChurnEvent>(it->second);
+        connected.erase(it);
+      }
+
+      if (round % 50 == 0) {
+        std::map<int, int> calls;
+        bus.emit(ChurnEvent{&calls});
+        REQUIRE(calls.size() == connected.size());
+        for (const auto& [listener, id] : connected) {
+          REQUIRE(calls[listener] == 1);
+        }
+        REQUIRE(bus.count<ChurnEvent>() == connected.size());
+      }
+    }
+  }
+}
+
+TEST_CASE("EventBus posted events") {
+  deskgui::EventBus bus;
+  int wakeups = 0;
+  bus.setWakeup([&wakeups] { ++wakeups; });
+
+  SECTION("Events are delivered by drain, in post order") {
+    std::vector<int> values;
+    bus.connect<QueuedEvent>([&values](QueuedEvent& event) { values.push_back(event.value); });
+
+    bus.post<QueuedEvent>(1);
+    bus.post<QueuedEvent>(2);
+    bus.post<QueuedEvent>(3);
+    CHECK(values.empty());
+    CHECK(wakeups == 1);
+    CHECK(bus.hasPosted());
+
+    bus.drain();
+    CHECK(values == std::vector<int>{1, 2, 3});
+    CHECK_FALSE(bus.hasPosted());
+  }
+
+  SECTION("Only the latest kLatestWins event is delivered") {
+    std::vector<deskgui::ViewSize> sizes;
+    bus.connect<deskgui::event::WindowResize>(
+        [&sizes](deskgui::event::WindowResize& event) { sizes.push_back(event.size); });
+
+    bus.post<deskgui::event::WindowResize>(deskgui::ViewSize{1, 1});
+    bus.post<deskgui::event::WindowResize>(deskgui::ViewSize{2, 2});
+    bus.post<deskgui::event::WindowResize>(deskgui::ViewSize{3, 3});
+    bus.drain();
+    CHECK(sizes == std::vector<deskgui::ViewSize>{{3, 3}});
+    CHECK(wakeups == 1);
+  }
+
+  SECTION("kCountOnly events are delivered once with the number of posts") {
+    std::vector<std::size_t> counts;
+    bus.connect<CountedEvent>([&counts](CountedEvent& event) { counts.push_back(event.count); });
+
+    for (int post = 0; post < 5; ++post) {
+      bus.post<CountedEvent>();
+    }
+    bus.drain();
+    bus.post<CountedEvent>();
+    bus.drain();
+    CHECK(counts == std::vector<std::size_t>{5, 1});
+    CHECK(wakeups == 2);
+  }
+}
+
+TEST_CASE("EventBus asynchronous listeners") {
+  deskgui::EventBus bus;
+
+  SECTION("Listeners receive a copy of the event on the shared pool") {
+    std::promise<std::pair<int, std::thread::id>> received;
+    bus.connectAsync<AsyncEvent>([&received](const AsyncEvent& event) {
+      received.set_value({event.value, std::this_thread::get_id()});
+    });
+
+    bus.emit(AsyncEvent{7});
+    auto future = received.get_future();
+    REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    const auto [value, thread] = future.get();
+    CHECK(value == 7);
+    CHECK(thread != std::this_thread::get_id());
+  }
+}
@@ -0,0 +1,99 @@
+#include <deskgui/json_traits.h>
+
+#include <catch2/catch_all.hpp>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+  struct Point {
+    int x;
+    int y;
+  };
+
+  template <typename Signature, typename Function>
+  std::string call(Function function, const char* args) {
+    rapidjson::Document document;
+    document.Parse(args);
+    rapidjson::StringBuffer buffer;
+    deskgui::JsonWriter writer(buffer);
+    deskgui::JsonFunction<Signature>::call(function, document, writer);
+    return {buffer.GetString(), buffer.GetSize()};
+  }
+}  // namespace
+
+template <> struct deskgui::JsonTraits<Point> {
+  static Point read(const rapidjson::Value& value) {
+    if (!value.IsObject() || !value.HasMember("x") || !value.HasMember("y")) {
+      throw std::invalid_argument("Expected a point");
+    }
+    return {JsonTraits<int>::read(value["x"]), JsonTraits<int>::read(value["y"])};
+  }
+  static void write(JsonWriter& writer, const Point& point) {
+    writer.StartObject();
+    writer.Key("x");
+    writer.Int(point.x);
+    writer.Key("y");
+    writer.Int(point.y);
+    writer.EndObject();
+  }
+};
+
+TEST_CASE("Typed bound functions") {
+  SECTION("Arithmetic and string arguments") {
+    CHECK(call<int(int, int)>([](int a, int b) { return a + b; }, "[2, 3]") == "5");
+    CHECK(call<double(double)>([](double value) { return value / 2; }, "[3]") == "1.5");
+    CHECK(call<bool(bool)>([](bool value) { return !value; }, "[false]") == "true");
+    CHECK(call<std::string(const std::string&)>([](const std::string& name) { return name + "!"; },
+                                               R"(["hi \"you\""])")
+          == R"("hi \"you\"!")");
+  }
+
+  SECTION("Containers") {
+    using Values = std::vector<int>;
+    const auto reverse = [](const Values& values) { return Values(values.rbegin(), values.rend()); };
+    CHECK(call<Values(const Values&)>(reverse, "[[1, 2, 3]]") == "[3,2,1]");
+
+    using Scores = std::map<std::string, std::vector<double>>;
+    CHECK(call<Scores(Scores)>([](Scores scores) { return scores; }, R"([{"a": [1.5], "b": []}])")
+          == R"({"a":[1.5],"b":[]})");
+
+    using Counts = std::unordered_map<std::string, unsigned>;
+    CHECK(call<std::size_t(const Counts&)>([](const Counts& counts) { return counts.at("n"); },
+                                           R"([{"n": 7}])")
+          == "7");
+  }
+
+  SECTION("User types opt in through JsonTraits") {
+    CHECK(call<Point(Point)>([](Point point) { return Point{point.y, point.x}; },
+                             R"([{"x": 1, "y": 2}])")
+          == R"({"x":2,"y":1})");
+  }
+
+  SECTION("Void functions resolve to null") {
+    int calls = 0;
+    CHECK(call<void()>([&calls] { ++calls; }, "[]") == "null");
+    CHECK(calls == 1);
+  }
+
+  SECTION("Mismatched arguments are rejected") {
+    const auto add = [](int a, int b) { return a + b; };
+    CHECK_THROWS_AS(call<int(int, int)>(add, "[1]"), std::invalid_argument);
+    CHECK_THROWS_AS(call<int(int, int)>(add, R"([1, "2"])"), std::invalid_argument);
+    CHECK_THROWS_AS(call<int(int, int)>(add, "[1, 2.5]"), std::invalid_argument);
+    CHECK_THROWS_AS(call<int(int, int)>(add, "{}"), std::invalid_argument);
+    CHECK_THROWS_AS(call<std::uint8_t(std::uint8_t)>([](std::uint8_t value) { return value; },
+                                                     "[256]"),
+                    std::invalid_argument);
+  }
+
+  SECTION("Non-finite results are rejected") {
+    CHECK_THROWS_AS(call<double(double)>([](double value) { return value / 0.0; }, "[1]"),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(call<double(double)>([](double value) { return std::sqrt(value); }, "[-1]"),
+                    std::invalid_argument);
+  }
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch_all.hpp>
+#include <string>
+
+#include "utils/message_parser.h"
+
+TEST_CASE("MessageParser") {
+  deskgui::MessageParser parser;
+
+  SECTION("Members are read from the parsed message") {
+    REQUIRE(parser.parse(R"({"key": "a\"b", "type": "bind", "payload": {"x": 1}})"));
+    CHECK(parser.string("key") == "a\"b");
+    CHECK(parser.string("type") == "bind");
+    CHECK(parser.string("missing").empty());
+    REQUIRE(parser.value("payload"));
+    CHECK(parser.value("payload")->IsObject());
+    CHECK_FALSE(parser.value("missing"));
+  }
+
+  SECTION("Raw members are sliced out of the message as written") {
+    REQUIRE(parser.parse(
+        R"({ "key" : "a\"b", "payload" :  {"x": [1, 2, "y\n"], "z": {}} , "type":"bind"})"));
+    CHECK(parser.raw("payload") == R"({"x": [1, 2, "y\n"], "z": {}})");
+    CHECK(parser.raw("key") == R"("a\"b")");
+    CHECK(parser.raw("type") == R"("bind")");
+    CHECK(parser.raw("missing").empty());
+  }
+
+  SECTION("Scalars, arrays and nested members of the same name") {
+    REQUIRE(parser.parse(R"({"payload":12.5,"key":"k"})"));
+    CHECK(parser.raw("payload") == "12.5");
+
+    REQUIRE(parser.parse(R"({"payload":[true,null]})"));
+    CHECK(parser.raw("payload") == "[true,null]");
+
+    REQUIRE(parser.parse(R"({"a":{"payload":1},"payload":false})"));
+    CHECK(parser.raw("payload") == "false");
+    CHECK(parser.raw("a") == R"({"payload":1})");
+  }
+
+  SECTION("Bind calls") {
+    REQUIRE(parser.parse(R"({"b":1,"k":"echo","i":42,"p":[1,{"a":"é"}]})"));
+    CHECK(parser.string("k") == "echo");
+    REQUIRE(parser.value("i"));
+    CHECK(parser.value("i")->GetUint64() == 42);
+    CHECK(parser.raw("p") == R"([1,{"a":"é"}])");
+  }
+
+  SECTION("Messages that are not JSON objects") {
+    CHECK_FALSE(parser.parse("[1]"));
+    CHECK_FALSE(parser.parse("{bad"));
+    CHECK_FALSE(parser.parse("plain text"));
+    CHECK(parser.raw("payload").empty());
+  }
+
+  SECTION("The parser is reused past its first pool chunk") {
+    std::string message = R"({"payload":[)";
+    for (int value = 0; value < 2000; ++value) {
+      message += std::to_string(value) + ",";
+    }
+    message += "0]}";
+
+    REQUIRE(parser.parse(message));
+    CHECK(parser.value("payload")->Size() == 2001);
+
+    REQUIRE(parser.parse(R"({"key":"k"})"));
+    CHECK(parser.string("key") == "k");
+    CHECK_FALSE(parser.value("payload"));
+  }
+}
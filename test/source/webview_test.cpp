@@ -28,4 +28,44 @@ TEST_CASE("Webview tests") {
     CHECK("file://" + file + "/" == webview->getUrl());
   }
 
+  SECTION("Bound results containing commas resolve") {
+    webview->bind("comma", [](const std::string&) { return std::string("1,2"); });
+
+    std::string settled;
+    webview->connect<event::WebviewOnMessage>("settled",
+                                              [&app, &settled](const event::WebviewOnMessage& event) {
+                                                settled = event.message;
+                                                app.terminate();
+                                              });
+    webview->connect<event::WebviewContentLoaded>([&webview]() {
+      webview->executeScript(
+          "comma().then((value) => window.webview.postMessage({key: 'settled', payload: value}),"
+          " () => window.webview.postMessage({key: 'settled', payload: 'rejected'}));");
+    });
+    webview->loadHTMLString("<html><body></body></html>");
+    app.run();
+    CHECK(settled.find("\"payload\":2") != std::string::npos);
+  }
+
+  SECTION("Bind calls don't reach keyed message listeners") {
+    webview->bind("ping", [](const std::string&) { return std::string("1"); });
+
+    bool keyed = false;
+    webview->connect<event::WebviewOnMessage>("ping",
+                                              [&keyed](const event::WebviewOnMessage&) {
+                                                keyed = true;
+                                              });
+    webview->connect<event::WebviewOnMessage>("settled",
+                                              [&app](const event::WebviewOnMessage&) {
+                                                app.terminate();
+                                              });
+    webview->connect<event::WebviewContentLoaded>([&webview]() {
+      webview->executeScript(
+          "ping().finally(() => window.webview.postMessage({key: 'settled', payload: 0}));");
+    });
+    webview->loadHTMLString("<html><body></body></html>");
+    app.run();
+    CHECK_FALSE(keyed);
+  }
+
 }
@@ -4,6 +4,8 @@
 #include <catch2/catch_all.hpp>
 #include <chrono>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <thread>
 
 namespace {
@@ -33,6 +35,7 @@ TEST_CASE("Window basic functionality") {
     constexpr auto expectedTitle = "Window tests";
     window->setTitle(expectedTitle);
     CHECK(window->getTitle() == expectedTitle);
+    CHECK(window->getTitle(deskgui::ReadMode::kFresh) == expectedTitle);
   }
 
   SECTION("Set and get size") {
@@ -56,6 +59,7 @@ TEST_CASE("Window basic functionality") {
   SECTION("Resizable flag") {
     window->setResizable(true);
     CHECK(window->isResizable());
+    CHECK(window->isResizable(deskgui::ReadMode::kFresh));
 
     window->setResizable(false);
     CHECK_FALSE(window->isResizable());
@@ -72,6 +76,15 @@ TEST_CASE("Window basic functionality") {
     CHECK(actual == expectedPos);
   }
 
+  SECTION("Cached geometry is read from the native window") {
+    using deskgui::PixelsType;
+    using deskgui::ReadMode;
+    CHECK(window->getSize(PixelsType::kPhysical, ReadMode::kCached)
+          == window->getSize(PixelsType::kPhysical));
+    CHECK(window->getPosition(PixelsType::kPhysical, ReadMode::kCached)
+          == window->getPosition(PixelsType::kPhysical));
+  }
+
   SECTION("Decorations flag") {
     window->setDecorations(true);
     CHECK(window->isDecorated());
@@ -79,4 +92,49 @@ TEST_CASE("Window basic functionality") {
     window->setDecorations(false);
     CHECK_FALSE(window->isDecorated());
   }
+
+  SECTION("Batch applies the last geometry") {
+    constexpr deskgui::ViewSize expectedSize{600, 600};
+    const auto title = window->batch([&expectedSize](deskgui::Window& window) {
+      window.setTitle("Batch");
+      window.setSize({300, 300});
+      window.setMinSize(expectedSize);
+      window.setSize(expectedSize);
+      return window.getTitle();
+    });
+
+    CHECK(title == "Batch");
+    CHECK(toDips(window->getMinSize(), scale) == expectedSize);
+    CHECK(toDips(window->getSize(), scale) == expectedSize);
+  }
+
+  SECTION("Batch accepts move-only operations") {
+    auto title = std::make_unique<std::string>("Move-only");
+    window->batch([title = std::move(title)](deskgui::Window& window) { window.setTitle(*title); });
+
+    CHECK(window->getTitle() == "Move-only");
+  }
+}
+
+TEST_CASE("Window batch abandoned at application destruction") {
+  std::atomic<bool> abandoned{false};
+  std::thread worker;
+  {
+    deskgui::App app;
+    auto window = app.createWindow("window");
+    REQUIRE(window);
+
+    // The main loop never runs, so the batch is still queued when the app is destroyed
+    worker = std::thread([window, &abandoned] {
+      try {
+        window->batch([](deskgui::Window& window) { return window.getTitle(); });
+      } catch (const std::runtime_error&) {
+        abandoned = true;
+      }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  worker.join();
+
+  CHECK(abandoned);
 }